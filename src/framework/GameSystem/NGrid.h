@@ -165,6 +165,28 @@ class NGrid
             return count;
         }
 
+        template<class SPECIFIC_OBJECT>
+        uint32 GridObjectCount() const
+        {
+            uint32 count = 0;
+            for (uint32 x = 0; x < N; ++x)
+                for (uint32 y = 0; y < N; ++y)
+                    count += i_cells[x][y].template GridObjectCount<SPECIFIC_OBJECT>();
+
+            return count;
+        }
+
+        template<class SPECIFIC_OBJECT>
+        uint32 WorldObjectCount() const
+        {
+            uint32 count = 0;
+            for (uint32 x = 0; x < N; ++x)
+                for (uint32 y = 0; y < N; ++y)
+                    count += i_cells[x][y].template WorldObjectCount<SPECIFIC_OBJECT>();
+
+            return count;
+        }
+
         template<class SPECIFIC_OBJECT>
         bool AddGridObject(const uint32 x, const uint32 y, SPECIFIC_OBJECT* obj)
         {
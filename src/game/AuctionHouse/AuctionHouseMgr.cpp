@@ -438,6 +438,28 @@ bool AuctionHouseMgr::RemoveAItem(uint32 id)
     return true;
 }
 
+std::wstring const& AuctionHouseMgr::GetItemSearchName(uint32 itemEntry, int32 locale)
+{
+    uint64 key = (uint64(uint32(locale + 1)) << 32) | itemEntry;
+    ItemSearchNameMap::const_iterator itr = mItemSearchNames.find(key);
+    if (itr != mItemSearchNames.end())
+        return itr->second;
+
+    std::wstring& wname = mItemSearchNames[key];
+    if (ItemPrototype const* proto = ObjectMgr::GetItemPrototype(itemEntry))
+    {
+        std::string name = proto->Name1;
+        sObjectMgr.GetItemLocaleStrings(itemEntry, locale, &name);
+
+        // not convertible names stay empty and never match non empty search
+        if (Utf8toWStr(name, wname))
+            wstrToLower(wname);
+        else
+            wname.clear();
+    }
+    return wname;
+}
+
 void AuctionHouseMgr::Update()
 {
     for (auto& mAuction : mAuctions)
@@ -520,137 +542,293 @@ AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(Unit* unit)
     return sAuctionHouseStore.LookupEntry(houseid);
 }
 
+static bool AuctionIdLess(AuctionEntry const* a, AuctionEntry const* b)
+{
+    return a->Id < b->Id;
+}
+
+static void AddToAuctionList(AuctionHouseObject::AuctionEntryList& list, AuctionEntry* auction)
+{
+    // new auctions get increasing ids so this is almost always a push back
+    list.insert(std::upper_bound(list.begin(), list.end(), auction, AuctionIdLess), auction);
+}
+
+static void RemoveFromAuctionList(AuctionHouseObject::AuctionEntryList& list, AuctionEntry* auction)
+{
+    AuctionHouseObject::AuctionEntryList::iterator itr = std::lower_bound(list.begin(), list.end(), auction, AuctionIdLess);
+    if (itr != list.end() && *itr == auction)
+        list.erase(itr);
+}
+
+static void AddToAuctionIndex(AuctionHouseObject::AuctionEntryIndex& index, uint32 key, AuctionEntry* auction)
+{
+    if (key)
+        AddToAuctionList(index[key], auction);
+}
+
+static void RemoveFromAuctionIndex(AuctionHouseObject::AuctionEntryIndex& index, uint32 key, AuctionEntry* auction)
+{
+    if (!key)
+        return;
+
+    AuctionHouseObject::AuctionEntryIndex::iterator itr = index.find(key);
+    if (itr == index.end())
+        return;
+
+    RemoveFromAuctionList(itr->second, auction);
+    if (itr->second.empty())
+        index.erase(itr);
+}
+
+void AuctionHouseObject::AddAuction(AuctionEntry* ah)
+{
+    MANGOS_ASSERT(ah);
+    AuctionsMap[ah->Id] = ah;
+    AddToSearchIndex(ah);
+    AddToAuctionIndex(m_ownerIndex, ah->owner, ah);
+    AddToAuctionIndex(m_bidderIndex, ah->bidder, ah);
+    m_expireQueue.push(AuctionExpireEntry(ah->expireTime, ah->Id));
+}
+
+bool AuctionHouseObject::RemoveAuction(uint32 id)
+{
+    AuctionEntryMap::iterator itr = AuctionsMap.find(id);
+    if (itr == AuctionsMap.end())
+        return false;
+
+    AuctionEntry* auction = itr->second;
+    RemoveFromSearchIndex(auction);
+    RemoveFromAuctionIndex(m_ownerIndex, auction->owner, auction);
+    RemoveFromAuctionIndex(m_bidderIndex, auction->bidder, auction);
+    // m_expireQueue entry is skipped at pop
+    AuctionsMap.erase(itr);
+    return true;
+}
+
+void AuctionHouseObject::SetAuctionBidder(AuctionEntry* auction, uint32 bidder)
+{
+    if (auction->bidder == bidder)
+        return;
+
+    RemoveFromAuctionIndex(m_bidderIndex, auction->bidder, auction);
+    auction->bidder = bidder;
+    AddToAuctionIndex(m_bidderIndex, auction->bidder, auction);
+}
+
+void AuctionHouseObject::SetAuctionExpireTime(AuctionEntry* auction, time_t expireTime)
+{
+    if (auction->expireTime == expireTime)
+        return;
+
+    // old queue entry becomes stale
+    auction->expireTime = expireTime;
+    m_expireQueue.push(AuctionExpireEntry(expireTime, auction->Id));
+}
+
+void AuctionHouseObject::AddToSearchIndex(AuctionEntry* auction)
+{
+    m_searchCache.clear();
+
+    ItemPrototype const* proto = ObjectMgr::GetItemPrototype(auction->itemTemplate);
+    if (!proto)
+        return;
+
+    AddToAuctionList(m_classIndex[proto->Class], auction);
+    AddToAuctionList(m_subClassIndex[MAKE_PAIR32(proto->SubClass, proto->Class)], auction);
+}
+
+void AuctionHouseObject::RemoveFromSearchIndex(AuctionEntry* auction)
+{
+    m_searchCache.clear();
+
+    ItemPrototype const* proto = ObjectMgr::GetItemPrototype(auction->itemTemplate);
+    if (!proto)
+        return;
+
+    AuctionEntryIndex::iterator itr = m_classIndex.find(proto->Class);
+    if (itr != m_classIndex.end())
+        RemoveFromAuctionList(itr->second, auction);
+
+    itr = m_subClassIndex.find(MAKE_PAIR32(proto->SubClass, proto->Class));
+    if (itr != m_subClassIndex.end())
+        RemoveFromAuctionList(itr->second, auction);
+}
+
 void AuctionHouseObject::Update()
 {
     time_t curTime = sWorld.GetGameTime();
     ///- Handle expired auctions
-    for (AuctionEntryMap::iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end();)
+    while (!m_expireQueue.empty() && m_expireQueue.top().first <= curTime)
     {
-        if (curTime < itr->second->expireTime)
-        {
-            itr++;
+        AuctionExpireEntry expired = m_expireQueue.top();
+        m_expireQueue.pop();
+
+        ///- skip entries of already removed auctions or auctions with changed expire time
+        AuctionEntry* auction = GetAuction(expired.second);
+        if (!auction || auction->expireTime != expired.first)
             continue;
-        }
 
         ///- perform the transaction if there was bidder.  this will alyways have the side effect of
-        ///- removing the auction from the collection.  therefore we must increment the iterator here.
-        if (itr->second->bid)
-            (itr++)->second->AuctionBidWinning();
+        ///- removing the auction from the collection.
+        if (auction->bid)
+            auction->AuctionBidWinning();
         ///- cancel the auction if there was no bidder and clear the auction
         else
         {
-            sAuctionMgr.SendAuctionExpiredMail(itr->second);
+            sAuctionMgr.SendAuctionExpiredMail(auction);
 
-            itr->second->DeleteFromDB();
-            sAuctionMgr.RemoveAItem(itr->second->itemGuidLow);
-            delete itr->second;
-            AuctionsMap.erase(itr++);
+            auction->DeleteFromDB();
+            sAuctionMgr.RemoveAItem(auction->itemGuidLow);
+            RemoveAuction(auction->Id);
+            delete auction;
         }
     }
 }
 
-void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32 listfrom, uint32& count, uint32& totalcount)
+static void BuildListAuctionEntries(AuctionHouseObject::AuctionEntryIndex const& index, WorldPacket& data, Player* player, uint32 listfrom, uint32& count, uint32& totalcount)
 {
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    AuctionHouseObject::AuctionEntryIndex::const_iterator itr = index.find(player->GetGUIDLow());
+    if (itr == index.end())
+        return;
+
+    for (AuctionEntry* Aentry : itr->second)
     {
-        AuctionEntry* Aentry = itr->second;
-        if (Aentry->bidder == player->GetGUIDLow())
+        if (count < MAX_AUCTION_ITEMS_CLIENT_UI_PAGE && totalcount >= listfrom)
         {
-            if (count < MAX_AUCTION_ITEMS_CLIENT_UI_PAGE && totalcount >= listfrom)
-            {
-                if (!Aentry->BuildAuctionInfo(data))
-                    continue;
-                ++count;
-            }
-            ++totalcount;
+            if (!Aentry->BuildAuctionInfo(data))
+                continue;
+            ++count;
         }
+        ++totalcount;
     }
 }
 
+void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32 listfrom, uint32& count, uint32& totalcount)
+{
+    BuildListAuctionEntries(m_bidderIndex, data, player, listfrom, count, totalcount);
+}
+
 void AuctionHouseObject::BuildListOwnerItems(WorldPacket& data, Player* player, uint32 listfrom, uint32& count, uint32& totalcount)
 {
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    BuildListAuctionEntries(m_ownerIndex, data, player, listfrom, count, totalcount);
+}
+
+bool AuctionHouseObject::IsMatchingSearch(AuctionEntry const* auction, AuctionSearchKey const& key)
+{
+    Item* item = sAuctionMgr.GetAItem(auction->itemGuidLow);
+    if (!item)
+        return false;
+
+    ItemPrototype const* proto = item->GetProto();
+
+    if (key.itemClass != 0xffffffff && proto->Class != key.itemClass)
+        return false;
+
+    if (key.itemSubClass != 0xffffffff && proto->SubClass != key.itemSubClass)
+        return false;
+
+    if (key.inventoryType != 0xffffffff && proto->InventoryType != key.inventoryType)
     {
-        AuctionEntry* Aentry = itr->second;
-        if (Aentry->owner == player->GetGUIDLow())
+        if (key.inventoryType != INVTYPE_CHEST || proto->InventoryType != INVTYPE_ROBE)
         {
-            if (count < MAX_AUCTION_ITEMS_CLIENT_UI_PAGE && totalcount >= listfrom)
-            {
-                if (!Aentry->BuildAuctionInfo(data))
-                    continue;
-                ++count;
-            }
-            ++totalcount;
+            // if inventory type is chest, we want to return robes too
+            // i.e. cloth chests are in most cases robes by definition
+
+            return false;
         }
     }
+
+    if (key.quality != 0xffffffff && proto->Quality < key.quality)
+        return false;
+
+    if (key.levelmin != 0x00 && (proto->RequiredLevel < key.levelmin || (key.levelmax != 0x00 && proto->RequiredLevel > key.levelmax)))
+        return false;
+
+    if (!key.name.empty() && sAuctionMgr.GetItemSearchName(proto->ItemId, key.locale).find(key.name) == std::wstring::npos)
+        return false;
+
+    return true;
 }
 
-void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player,
-        std::wstring const& wsearchedname, uint32 listfrom, uint32 levelmin, uint32 levelmax, uint32 usable,
-        uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
-        uint32& count, uint32& totalcount)
+void AuctionHouseObject::FindAuctions(AuctionSearchKey const& key, AuctionEntryList& result) const
 {
-    int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
-
-    for (auto& AentryItr : AuctionsMap)
+    // only walk the smallest bucket fitting the filter
+    AuctionEntryList const* bucket = nullptr;
+    if (key.itemClass != 0xffffffff)
     {
-        auto Aentry = AentryItr.second;
-        Item* item = sAuctionMgr.GetAItem(Aentry->itemGuidLow);
-        if (!item)
-            continue;
-
-        {
-            ItemPrototype const* proto = item->GetProto();
+        AuctionEntryIndex const& index = key.itemSubClass != 0xffffffff ? m_subClassIndex : m_classIndex;
+        uint32 bucketKey = key.itemSubClass != 0xffffffff ? MAKE_PAIR32(key.itemSubClass, key.itemClass) : key.itemClass;
 
-            if (itemClass != 0xffffffff && proto->Class != itemClass)
-                continue;
+        AuctionEntryIndex::const_iterator itr = index.find(bucketKey);
+        if (itr == index.end())
+            return;
 
-            if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
-                continue;
+        bucket = &itr->second;
+    }
 
-            if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
-            {
-                if (inventoryType != INVTYPE_CHEST || proto->InventoryType != INVTYPE_ROBE)
-                {
-                    // if inventory type is chest, we want to return robes too
-                    // i.e. cloth chests are in most cases robes by definition
+    if (bucket)
+    {
+        for (AuctionEntry* auction : *bucket)
+            if (IsMatchingSearch(auction, key))
+                result.push_back(auction);
+    }
+    else
+    {
+        for (auto& auctionItr : AuctionsMap)
+            if (IsMatchingSearch(auctionItr.second, key))
+                result.push_back(auctionItr.second);
+    }
+}
 
-                    continue;
-                }
-            }
+void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player,
+        std::wstring const& wsearchedname, uint32 listfrom, uint32 levelmin, uint32 levelmax, uint32 usable,
+        uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
+        uint32& count, uint32& totalcount)
+{
+    AuctionSearchKey key;
+    key.name = wsearchedname;
+    key.locale = player->GetSession()->GetSessionDbLocaleIndex();
+    key.levelmin = levelmin;
+    key.levelmax = levelmax;
+    key.inventoryType = inventoryType;
+    key.itemClass = itemClass;
+    key.itemSubClass = itemSubClass;
+    key.quality = quality;
+
+    // player independent part of the filter is cached, so paging through results is cheap
+    AuctionSearchCache::iterator cacheItr = m_searchCache.find(key);
+    if (cacheItr == m_searchCache.end())
+    {
+        if (m_searchCache.size() >= MAX_AUCTION_SEARCH_CACHE_SIZE)
+            m_searchCache.clear();
 
-            if (quality != 0xffffffff && proto->Quality < quality)
-                continue;
+        cacheItr = m_searchCache.emplace(key, AuctionEntryList()).first;
+        FindAuctions(key, cacheItr->second);
+    }
 
-            if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
+    for (AuctionEntry* Aentry : cacheItr->second)
+    {
+        if (usable != 0x00)
+        {
+            Item* item = sAuctionMgr.GetAItem(Aentry->itemGuidLow);
+            if (!item || player->CanUseItem(item) != EQUIP_ERR_OK)
                 continue;
 
-            if (usable != 0x00)
+            ItemPrototype const* proto = item->GetProto();
+            if (proto->Class == ITEM_CLASS_RECIPE)
             {
-                if (player->CanUseItem(item) != EQUIP_ERR_OK)
-                    continue;
-
-                if (proto->Class == ITEM_CLASS_RECIPE)
+                if (SpellEntry const* spell = sSpellTemplate.LookupEntry<SpellEntry>(proto->Spells[0].SpellId))
                 {
-                    if (SpellEntry const* spell = sSpellTemplate.LookupEntry<SpellEntry>(proto->Spells[0].SpellId))
-                    {
-                        if (player->HasSpell(spell->EffectTriggerSpell[EFFECT_INDEX_0]))
-                            continue;
-                    }
+                    if (player->HasSpell(spell->EffectTriggerSpell[EFFECT_INDEX_0]))
+                        continue;
                 }
             }
+        }
 
-            std::string name = proto->Name1;
-            sObjectMgr.GetItemLocaleStrings(proto->ItemId, loc_idx, &name);
-
-            if (!wsearchedname.empty() && !Utf8FitTo(name, wsearchedname))
-                continue;
-
-            if (count < MAX_AUCTION_ITEMS_CLIENT_UI_PAGE && totalcount >= listfrom)
-            {
-                ++count;
-                Aentry->BuildAuctionInfo(data);
-            }
+        if (count < MAX_AUCTION_ITEMS_CLIENT_UI_PAGE && totalcount >= listfrom)
+        {
+            ++count;
+            Aentry->BuildAuctionInfo(data);
         }
 
         ++totalcount;
@@ -799,7 +977,7 @@ bool AuctionEntry::UpdateBid(uint32 newbid, Player* newbidder /*=nullptr*/)
             WorldSession::SendAuctionOutbiddedMail(this);
     }
 
-    bidder = newbidder ? newbidder->GetGUIDLow() : 0;
+    sAuctionMgr.GetAuctionsMap(auctionHouseEntry)->SetAuctionBidder(this, newbidder ? newbidder->GetGUIDLow() : 0);
     bid = newbid;
 
     if ((newbid < buyout) || (buyout == 0))                 // bid
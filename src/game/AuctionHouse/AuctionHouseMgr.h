@@ -22,6 +22,8 @@
 #include "Common.h"
 #include "Server/DBCStructure.h"
 
+#include <tuple>
+
 class Item;
 class Player;
 class Unit;
@@ -79,6 +81,27 @@ struct AuctionEntry
     bool UpdateBid(uint32 newbid, Player* newbidder = nullptr);// true if normal bid, false if buyout, bidder==nullptr for generated bid
 };
 
+// filter part of CMSG_AUCTION_LIST_ITEMS that doesn't depend on searching player
+struct AuctionSearchKey
+{
+    std::wstring name;                                      // lower case, empty for any
+    int32 locale;
+    uint32 levelmin;
+    uint32 levelmax;
+    uint32 inventoryType;
+    uint32 itemClass;
+    uint32 itemSubClass;
+    uint32 quality;
+
+    bool operator<(AuctionSearchKey const& other) const
+    {
+        return std::tie(name, locale, levelmin, levelmax, inventoryType, itemClass, itemSubClass, quality) <
+               std::tie(other.name, other.locale, other.levelmin, other.levelmax, other.inventoryType, other.itemClass, other.itemSubClass, other.quality);
+    }
+};
+
+#define MAX_AUCTION_SEARCH_CACHE_SIZE 256
+
 // this class is used as auctionhouse instance
 class AuctionHouseObject
 {
@@ -92,17 +115,18 @@ class AuctionHouseObject
 
         typedef std::map<uint32, AuctionEntry*> AuctionEntryMap;
         typedef std::pair<AuctionEntryMap::const_iterator, AuctionEntryMap::const_iterator> AuctionEntryMapBounds;
+        typedef std::vector<AuctionEntry*> AuctionEntryList;   // always ordered by auction id, same as AuctionsMap
+        typedef std::unordered_map<uint32, AuctionEntryList> AuctionEntryIndex;
+        typedef std::map<AuctionSearchKey, AuctionEntryList> AuctionSearchCache;
+        typedef std::pair<time_t, uint32 /*auction id*/> AuctionExpireEntry;
+        typedef std::priority_queue<AuctionExpireEntry, std::vector<AuctionExpireEntry>, std::greater<AuctionExpireEntry>> AuctionExpireQueue;
 
         uint32 GetCount() const { return AuctionsMap.size(); }
 
         AuctionEntryMap const& GetAuctions() const { return AuctionsMap; }
         AuctionEntryMapBounds GetAuctionsBounds() const {return AuctionEntryMapBounds(AuctionsMap.begin(), AuctionsMap.end()); }
 
-        void AddAuction(AuctionEntry* ah)
-        {
-            MANGOS_ASSERT(ah);
-            AuctionsMap[ah->Id] = ah;
-        }
+        void AddAuction(AuctionEntry* ah);
 
         AuctionEntry* GetAuction(uint32 id) const
         {
@@ -110,7 +134,11 @@ class AuctionHouseObject
             return itr != AuctionsMap.end() ? itr->second : nullptr;
         }
 
-        bool RemoveAuction(uint32 id) { return !!AuctionsMap.erase(id); }
+        bool RemoveAuction(uint32 id);
+
+        // must be used instead of direct field changes for auctions stored in this house
+        void SetAuctionBidder(AuctionEntry* auction, uint32 bidder);
+        void SetAuctionExpireTime(AuctionEntry* auction, time_t expireTime);
 
         void Update();
 
@@ -122,7 +150,25 @@ class AuctionHouseObject
                                    uint32& count, uint32& totalcount);
         AuctionEntry* AddAuction(AuctionHouseEntry const* auctionHouseEntry, Item* newItem, uint32 etime, uint32 bid, uint32 buyout = 0, uint32 deposit = 0, Player* pl = nullptr);
     private:
+        void AddToSearchIndex(AuctionEntry* auction);
+        void RemoveFromSearchIndex(AuctionEntry* auction);
+        void FindAuctions(AuctionSearchKey const& key, AuctionEntryList& result) const;
+        static bool IsMatchingSearch(AuctionEntry const* auction, AuctionSearchKey const& key);
+
         AuctionEntryMap AuctionsMap;
+
+        // search buckets by item class and by item class/subclass pair
+        AuctionEntryIndex m_classIndex;
+        AuctionEntryIndex m_subClassIndex;
+        // player independent search results, dropped at any auction add/remove
+        AuctionSearchCache m_searchCache;
+
+        // player auctions by owner and by bidder low guid, server side (0) ones are not indexed
+        AuctionEntryIndex m_ownerIndex;
+        AuctionEntryIndex m_bidderIndex;
+
+        // earliest expiring auction on top, entries not matching auction expire time anymore are skipped
+        AuctionExpireQueue m_expireQueue;
 };
 
 enum AuctionHouseType
@@ -145,7 +191,7 @@ class AuctionHouseMgr
         AuctionHouseObject* GetAuctionsMap(AuctionHouseType houseType) { return &mAuctions[houseType]; }
         AuctionHouseObject* GetAuctionsMap(AuctionHouseEntry const* house);
 
-        Item* GetAItem(uint32 id)
+        Item* GetAItem(uint32 id) const
         {
             ItemMap::const_iterator itr = mAitems.find(id);
             if (itr != mAitems.end())
@@ -164,6 +210,9 @@ class AuctionHouseMgr
         static uint32 GetAuctionHouseTeam(AuctionHouseEntry const* house);
         static AuctionHouseEntry const* GetAuctionHouseEntry(Unit* unit);
 
+        // lower case item name used for auction search, cached per locale
+        std::wstring const& GetItemSearchName(uint32 itemEntry, int32 locale);
+
     public:
         // load first auction items, because of check if item exists, when loading
         void LoadAuctionItems();
@@ -178,6 +227,9 @@ class AuctionHouseMgr
         AuctionHouseObject  mAuctions[MAX_AUCTION_HOUSE_TYPE];
 
         ItemMap             mAitems;
+
+        typedef std::unordered_map<uint64, std::wstring> ItemSearchNameMap;
+        ItemSearchNameMap   mItemSearchNames;
 };
 
 #define sAuctionMgr MaNGOS::Singleton<AuctionHouseMgr>::Instance()
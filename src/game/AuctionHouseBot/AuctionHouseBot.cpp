@@ -279,7 +279,8 @@ void AuctionHouseBot::Rebuild(bool all)
     sLog.outString("AHBot: Rebuilding auction house items");
     for (uint32 i = 0; i < MAX_AUCTION_HOUSE_TYPE; ++i)
     {
-        AuctionHouseObject::AuctionEntryMapBounds bounds = sAuctionMgr.GetAuctionsMap(AuctionHouseType(i))->GetAuctionsBounds();
+        AuctionHouseObject* auctionHouse = sAuctionMgr.GetAuctionsMap(AuctionHouseType(i));
+        AuctionHouseObject::AuctionEntryMapBounds bounds = auctionHouse->GetAuctionsBounds();
         for (AuctionHouseObject::AuctionEntryMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
         {
             AuctionEntry* entry = itr->second;
@@ -287,7 +288,7 @@ void AuctionHouseBot::Rebuild(bool all)
             {
                 // ahbot auction
                 if (all || entry->bid == 0) // expire auction if no bid or forced
-                    entry->expireTime = sWorld.GetGameTime();
+                    auctionHouse->SetAuctionExpireTime(entry, sWorld.GetGameTime());
             }
         }
     }
@@ -57,6 +57,10 @@ BattleGroundQueue::BattleGroundQueue()
                 m_waitTimes[i][j][k] = 0;
         }
     }
+
+    for (auto& waitingPlayers : m_waitingPlayers)
+        for (uint32& count : waitingPlayers)
+            count = 0;
 }
 
 BattleGroundQueue::~BattleGroundQueue()
@@ -176,6 +180,9 @@ GroupQueueInfo* BattleGroundQueue::AddGroup(Player* leader, Group* group, Battle
     if (queueInfo->groupTeam == HORDE)
         ++index;                                            // BG_QUEUE_*_ALLIANCE -> BG_QUEUE_*_HORDE
 
+    queueInfo->bracketId                 = bracketId;
+    queueInfo->queueIndex                = index;
+
     DEBUG_LOG("Adding Group to BattleGroundQueue bgTypeId : %u, bracket_id : %u, index : %u", bgTypeId, bracketId, index);
 
     uint32 lastOnlineTime = WorldTimer::getMSTime();
@@ -207,6 +214,7 @@ GroupQueueInfo* BattleGroundQueue::AddGroup(Player* leader, Group* group, Battle
 
         // add GroupInfo to m_QueuedGroups
         m_queuedGroups[bracketId][index].push_back(queueInfo);
+        m_waitingPlayers[bracketId][index] += queueInfo->players.size();
 
         // announce to world, this code needs mutex
         if (!isPremade && sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_QUEUE_ANNOUNCER_JOIN))
@@ -215,17 +223,9 @@ GroupQueueInfo* BattleGroundQueue::AddGroup(Player* leader, Group* group, Battle
             {
                 char const* bgName = bg->GetName();
                 uint32 minPlayers = bg->GetMinPlayersPerTeam();
-                uint32 qHorde = 0;
-                uint32 qAlliance = 0;
+                uint32 qHorde = m_waitingPlayers[bracketId][BG_QUEUE_NORMAL_HORDE];
+                uint32 qAlliance = m_waitingPlayers[bracketId][BG_QUEUE_NORMAL_ALLIANCE];
                 uint32 q_min_level = leader->GetMinLevelForBattleGroundBracketId(bracketId, bgTypeId);
-                GroupsQueueType::const_iterator itr;
-                for (itr = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].begin(); itr != m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].end(); ++itr)
-                    if (!(*itr)->isInvitedToBgInstanceGuid)
-                        qAlliance += (*itr)->players.size();
-
-                for (itr = m_queuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].begin(); itr != m_queuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].end(); ++itr)
-                    if (!(*itr)->isInvitedToBgInstanceGuid)
-                        qHorde += (*itr)->players.size();
 
                 // Show queue status to player only (when joining queue)
                 if (sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_QUEUE_ANNOUNCER_JOIN) == 1)
@@ -309,8 +309,6 @@ void BattleGroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     // Player *plr = sObjectMgr.GetPlayer(guid);
     // std::lock_guard<std::recursive_mutex> guard(m_Lock);
 
-    int32 bracketId = -1;                                   // signed for proper for-loop finish
-
     // remove player from map, if he's there
     QueuedPlayersMap::iterator itr = m_queuedPlayers.find(guid);
     if (itr == m_queuedPlayers.end())
@@ -320,39 +318,18 @@ void BattleGroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     }
 
     GroupQueueInfo* group = itr->second.groupInfo;
-    GroupsQueueType::iterator group_itr;
-    // mostly people with the highest levels are in battlegrounds, thats why
-    // we count from MAX_BATTLEGROUND_QUEUES - 1 to 0
-    // variable index removes useless searching in other team's queue
-    uint32 index = GetTeamIndexByTeamId(group->groupTeam);
 
-    for (int8 bracketIdTmp = MAX_BATTLEGROUND_BRACKETS - 1; bracketIdTmp >= 0 && bracketId == -1; --bracketIdTmp)
-    {
-        // we must check premade and normal team's queue - because when players from premade are joining bg,
-        // they leave groupinfo so we can't use its players size to find out index
-        for (uint8 j = index; j < BG_QUEUE_GROUP_TYPES_COUNT; j += BG_QUEUE_NORMAL_ALLIANCE)
-        {
-            for (GroupsQueueType::iterator group_itr_tmp = m_queuedGroups[bracketIdTmp][j].begin(); group_itr_tmp != m_queuedGroups[bracketIdTmp][j].end(); ++group_itr_tmp)
-            {
-                if ((*group_itr_tmp) == group)
-                {
-                    bracketId = bracketIdTmp;
-                    group_itr = group_itr_tmp;
-                    // we must store index to be able to erase iterator
-                    index = j;
-                    break;
-                }
-            }
-        }
-    }
+    // the group knows its queue, only that one has to be searched
+    GroupsQueueType& groupQueue = m_queuedGroups[group->bracketId][group->queueIndex];
+    GroupsQueueType::iterator group_itr = std::find(groupQueue.begin(), groupQueue.end(), group);
 
     // player can't be in queue without group, but just in case
-    if (bracketId == -1)
+    if (group_itr == groupQueue.end())
     {
         sLog.outError("BattleGroundQueue: ERROR Cannot find groupinfo for %s", guid.GetString().c_str());
         return;
     }
-    DEBUG_LOG("BattleGroundQueue: Removing %s, from bracket_id %u", guid.GetString().c_str(), (uint32)bracketId);
+    DEBUG_LOG("BattleGroundQueue: Removing %s, from bracket_id %u", guid.GetString().c_str(), (uint32)group->bracketId);
 
     // ALL variables are correctly set
     // We can ignore leveling up in queue - it should not cause crash
@@ -362,7 +339,11 @@ void BattleGroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     // remove player queue info from group queue info
     GroupQueueInfoPlayers::iterator pitr = group->players.find(guid);
     if (pitr != group->players.end())
+    {
         group->players.erase(pitr);
+        if (!group->isInvitedToBgInstanceGuid)
+            --m_waitingPlayers[group->bracketId][group->queueIndex];
+    }
 
     // if invited to bg, and should decrease invited count, then do it
     if (decreaseInvitedCount && group->isInvitedToBgInstanceGuid)
@@ -378,7 +359,7 @@ void BattleGroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     // remove group queue info if needed
     if (group->players.empty())
     {
-        m_queuedGroups[bracketId][index].erase(group_itr);
+        groupQueue.erase(group_itr);
         delete group;
     }
 }
@@ -435,6 +416,7 @@ bool BattleGroundQueue::InviteGroupToBg(GroupQueueInfo* queueInfo, BattleGround*
         // not yet invited
         // set invitation
         queueInfo->isInvitedToBgInstanceGuid = bg->GetInstanceId();
+        m_waitingPlayers[queueInfo->bracketId][queueInfo->queueIndex] -= queueInfo->players.size();
         BattleGroundTypeId bgTypeId = bg->GetTypeId();
         BattleGroundQueueTypeId bgQueueTypeId = BattleGroundMgr::BgQueueTypeId(bgTypeId);
         BattleGroundBracketId bracket_id = bg->GetBracketId();
@@ -575,8 +557,8 @@ void BattleGroundQueue::FillPlayersToBg(BattleGround* bg, BattleGroundBracketId
 */
 bool BattleGroundQueue::CheckPremadeMatch(BattleGroundBracketId bracketId, uint32 minPlayersPerTeam, uint32 maxPlayersPerTeam)
 {
-    // check match
-    if (!m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].empty() && !m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].empty())
+    // check match, only when both premade queues have a group that is not invited yet
+    if (m_waitingPlayers[bracketId][BG_QUEUE_PREMADE_ALLIANCE] && m_waitingPlayers[bracketId][BG_QUEUE_PREMADE_HORDE])
     {
         // start premade match
         // if groups aren't invited
@@ -619,12 +601,15 @@ bool BattleGroundQueue::CheckPremadeMatch(BattleGroundBracketId bracketId, uint3
     {
         if (!m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE + i].empty())
         {
-            GroupsQueueType::iterator itr = m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE + i].begin();
-            if (!(*itr)->isInvitedToBgInstanceGuid && ((*itr)->joinTime < time_before || (*itr)->players.size() < minPlayersPerTeam))
+            GroupQueueInfo* queueInfo = m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE + i].front();
+            if (!queueInfo->isInvitedToBgInstanceGuid && (queueInfo->joinTime < time_before || queueInfo->players.size() < minPlayersPerTeam))
             {
                 // we must insert group to normal queue and erase pointer from premade queue
-                m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + i].push_front((*itr));
-                m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE + i].erase(itr);
+                m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE + i].pop_front();
+                m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE + i].push_front(queueInfo);
+                queueInfo->queueIndex = BG_QUEUE_NORMAL_ALLIANCE + i;
+                m_waitingPlayers[bracketId][BG_QUEUE_PREMADE_ALLIANCE + i] -= queueInfo->players.size();
+                m_waitingPlayers[bracketId][BG_QUEUE_NORMAL_ALLIANCE + i] += queueInfo->players.size();
             }
         }
     }
@@ -643,6 +628,15 @@ bool BattleGroundQueue::CheckPremadeMatch(BattleGroundBracketId bracketId, uint3
 */
 bool BattleGroundQueue::CheckNormalMatch(BattleGroundBracketId bracketId, uint32 minPlayers, uint32 maxPlayers)
 {
+    // not enough players waiting on one side, no need to walk the queues
+    if (sBattleGroundMgr.IsTesting())
+    {
+        if (!m_waitingPlayers[bracketId][BG_QUEUE_NORMAL_ALLIANCE] && !m_waitingPlayers[bracketId][BG_QUEUE_NORMAL_HORDE])
+            return false;
+    }
+    else if (m_waitingPlayers[bracketId][BG_QUEUE_NORMAL_ALLIANCE] < minPlayers || m_waitingPlayers[bracketId][BG_QUEUE_NORMAL_HORDE] < minPlayers)
+        return false;
+
     GroupsQueueType::const_iterator itr_team[PVP_TEAM_COUNT];
     for (uint8 i = 0; i < PVP_TEAM_COUNT; ++i)
     {
@@ -701,11 +695,11 @@ bool BattleGroundQueue::CheckNormalMatch(BattleGroundBracketId bracketId, uint32
 void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketId bracketId)
 {
     // std::lock_guard<std::recursive_mutex> guard(m_Lock);
-    // if no players in queue - do nothing
-    if (m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].empty() &&
-            m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].empty() &&
-            m_queuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].empty() &&
-            m_queuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].empty())
+    // if no players wait for an invite - do nothing
+    if (!m_waitingPlayers[bracketId][BG_QUEUE_PREMADE_ALLIANCE] &&
+            !m_waitingPlayers[bracketId][BG_QUEUE_PREMADE_HORDE] &&
+            !m_waitingPlayers[bracketId][BG_QUEUE_NORMAL_ALLIANCE] &&
+            !m_waitingPlayers[bracketId][BG_QUEUE_NORMAL_HORDE])
         return;
 
     // battleground with free slot for player should be always in the beggining of the queue
@@ -23,6 +23,7 @@
 #include "Policies/Singleton.h"
 #include "BattleGround.h"
 
+#include <deque>
 #include <mutex>
 
 typedef std::map<uint32, BattleGround*> BattleGroundSet;
@@ -54,6 +55,8 @@ struct GroupQueueInfo                                       // stores informatio
     uint32  removeInviteTime;                               // time when we will remove invite for players in group
     uint32  isInvitedToBgInstanceGuid;                      // was invited to certain BG
     uint32  desiredInstanceId;                              // queued for this instance specifically
+    BattleGroundBracketId bracketId;                        // bracket queue holding the group
+    uint8   queueIndex;                                     // BattleGroundQueueGroupTypes queue holding the group
 };
 
 enum BattleGroundQueueGroupTypes
@@ -101,7 +104,7 @@ class BattleGroundQueue
         QueuedPlayersMap m_queuedPlayers;
 
         // we need constant add to begin and constant remove / add from the end, therefore deque suits our problem well
-        typedef std::list<GroupQueueInfo*> GroupsQueueType;
+        typedef std::deque<GroupQueueInfo*> GroupsQueueType;
 
         /*
         This two dimensional array is used to store All queued groups
@@ -114,6 +117,10 @@ class BattleGroundQueue
         */
         GroupsQueueType m_queuedGroups[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
 
+        // players of the not yet invited groups in each of the queues above, kept up to date on join, leave and invite
+        // so a queue update can tell without walking the queues that no match is possible
+        uint32 m_waitingPlayers[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
+
         // class to select and invite groups to bg
         class SelectionPool
         {
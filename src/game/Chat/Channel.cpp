@@ -108,9 +108,7 @@ void Channel::Join(Player* player, const char* password)
 
     data.clear();
 
-    PlayerInfo& pinfo = m_players[guid];
-    pinfo.player = guid;
-    pinfo.flags = MEMBER_FLAG_NONE;
+    AddMember(player);
 
     MakeYouJoined(data, m_name, *this);
     SendToOne(data, guid);
@@ -150,7 +148,7 @@ void Channel::Leave(Player* player, bool send)
 
     bool changeowner = m_players[guid].IsOwner();
 
-    m_players.erase(guid);
+    RemoveMember(guid);
 
     const uint32 level = sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_CHANNEL_SILENT_JOIN);
     const bool silent = (level && player->GetSession()->GetSecurity() >= level);
@@ -229,7 +227,7 @@ void Channel::KickOrBan(Player* player, const char* targetName, bool ban)
         MakePlayerKicked(data, m_name, targetGuid, guid);
 
     SendToAll(data);
-    m_players.erase(targetGuid);
+    RemoveMember(targetGuid);
     target->LeftChannel(this);
 
     if (changeowner && !IsPublic())
@@ -733,16 +731,42 @@ void Channel::SendToOne(WorldPacket const& data, ObjectGuid receiver) const
 
 void Channel::SendToAll(WorldPacket const& data) const
 {
-    for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
-        SendToOne(data, i->first);
+    for (Player* member : m_members)
+        if (member->IsInWorld())
+            member->GetSession()->SendPacket(data);
 }
 
 void Channel::SendMessage(WorldPacket const& data, ObjectGuid sender) const
 {
-    for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
-        if (Player* plr = sObjectMgr.GetPlayer(i->first))
-            if (!sender || !plr->GetSocial()->HasIgnore(sender))
-                plr->GetSession()->SendPacket(data);
+    for (Player* member : m_members)
+        if (member->IsInWorld() && (!sender || !member->GetSocial()->HasIgnore(sender)))
+            member->GetSession()->SendPacket(data);
+}
+
+void Channel::AddMember(Player* player)
+{
+    PlayerInfo& pinfo = m_players[player->GetObjectGuid()];
+    pinfo.player = player->GetObjectGuid();
+    pinfo.flags = MEMBER_FLAG_NONE;
+    pinfo.member = uint32(m_members.size());
+    m_members.push_back(player);
+}
+
+void Channel::RemoveMember(ObjectGuid guid)
+{
+    PlayerList::iterator p_itr = m_players.find(guid);
+    if (p_itr == m_players.end())
+        return;
+
+    // players leave every channel before they are deleted, so the pointers never dangle
+    uint32 index = p_itr->second.member;
+    if (index + 1 != m_members.size())
+    {
+        m_members[index] = m_members.back();
+        m_players[m_members[index]->GetObjectGuid()].member = index;
+    }
+    m_members.pop_back();
+    m_players.erase(p_itr);
 }
 
 void Channel::MakeNotifyPacket(WorldPacket& data, const std::string& channel, ChatNotify type)
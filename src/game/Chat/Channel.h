@@ -25,6 +25,7 @@
 #include "Entities/Player.h"
 
 #include <map>
+#include <vector>
 
 #define SPEAK_IN_LOCALDEFENSE_RANK 0
 #define ENTER_HALL_RANK 6
@@ -133,6 +134,7 @@ class Channel
         {
             ObjectGuid player;
             uint8 flags;
+            uint32 member;                                  // index in m_members
 
             inline bool HasFlag(uint8 flag) const { return (flags & flag) != 0; }
             void SetFlag(uint8 flag, bool state) { if (state) flags |= flag; else flags &= ~flag; }
@@ -145,6 +147,8 @@ class Channel
         };
 
         typedef std::map<ObjectGuid, PlayerInfo> PlayerList;
+        // same players as PlayerList, kept contiguous so broadcasts need no guid lookups
+        typedef std::vector<Player*> MemberList;
 
     public:
         Channel(const std::string& name, uint32 channel_id = 0);
@@ -238,6 +242,9 @@ class Channel
             return p_itr->second.flags;
         }
 
+        void AddMember(Player* player);
+        void RemoveMember(ObjectGuid guid);
+
         ObjectGuid SelectNewOwner() const;
 
         void SetModeFlags(ObjectGuid guid, ChannelMemberFlags flags, bool set);
@@ -248,6 +255,7 @@ class Channel
         std::string                 m_password;
         ObjectGuid                  m_ownerGuid;
         PlayerList                  m_players;
+        MemberList                  m_members;
         GuidSet                     m_banned;
         const ChatChannelsEntry*    m_entry = nullptr;
         bool                        m_announcements = false;
@@ -232,6 +232,11 @@ ChatCommand* ChatHandler::getCommandTable()
     {
         { "tempspawn",      SEC_ADMINISTRATOR,  false, &ChatHandler::HandleShowTemporarySpawnList,          "", nullptr },
         { "gridsloaded",    SEC_ADMINISTRATOR,  false, &ChatHandler::HandleGridsLoadedCount,                "", nullptr },
+        { "aiupdate",       SEC_ADMINISTRATOR,  false, &ChatHandler::HandleAIUpdateStats,                   "", nullptr },
+        { "autosave",       SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleAutosaveStats,                   "", nullptr },
+        { "opcodes",        SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleOpcodeStats,                     "", nullptr },
+        { "dbscripts",      SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDbScriptQueueStats,              "", nullptr },
+        { "mapmemory",      SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleMapMemoryStats,                  "", nullptr },
         { nullptr,          0,                  false, nullptr,                                             "", nullptr }
     };
 
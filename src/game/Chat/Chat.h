@@ -288,6 +288,11 @@ class ChatHandler
 
         bool HandleShowTemporarySpawnList(char* args);
         bool HandleGridsLoadedCount(char* args);
+        bool HandleAIUpdateStats(char* args);
+        bool HandleAutosaveStats(char* args);
+        bool HandleOpcodeStats(char* args);
+        bool HandleDbScriptQueueStats(char* args);
+        bool HandleMapMemoryStats(char* args);
 
         bool HandleDebugPlayCinematicCommand(char* args);
         bool HandleDebugPlaySoundCommand(char* args);
@@ -6187,9 +6187,10 @@ bool ChatHandler::HandleInstanceStatsCommand(char* /*args*/)
     PSendSysMessage("instances loaded: %d", sMapMgr.GetNumInstances());
     PSendSysMessage("players in instances: %d", sMapMgr.GetNumPlayersInInstances());
 
-    uint32 numSaves, numBoundPlayers, numBoundGroups;
-    sMapPersistentStateMgr.GetStatistics(numSaves, numBoundPlayers, numBoundGroups);
+    uint32 numSaves, numBoundPlayers, numBoundGroups, numHibernated;
+    sMapPersistentStateMgr.GetStatistics(numSaves, numBoundPlayers, numBoundGroups, numHibernated);
     PSendSysMessage("instance saves: %d", numSaves);
+    PSendSysMessage("hibernated saves: %d", numHibernated);
     PSendSysMessage("players bound: %d", numBoundPlayers);
     PSendSysMessage("groups bound: %d", numBoundGroups);
     return true;
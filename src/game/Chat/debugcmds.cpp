@@ -36,6 +36,8 @@
 #include "Maps/InstanceData.h"
 #include "Cinematics/M2Stores.h"
 #include "Entities/Transports.h"
+#include "World/PlayerSaveScheduler.h"
+#include "World/World.h"
 
 bool ChatHandler::HandleDebugSendSpellFailCommand(char* args)
 {
@@ -1420,6 +1422,103 @@ bool ChatHandler::HandleGridsLoadedCount(char* /*args*/)
     return true;
 }
 
+bool ChatHandler::HandleAIUpdateStats(char* /*args*/)
+{
+    Player* player = m_session->GetPlayer();
+    if (!player)
+        return false;
+
+    AIUpdateScheduler& scheduler = player->GetMap()->GetAIUpdateScheduler();
+    if (!scheduler.IsEnabled())
+    {
+        SendSysMessage("AI level of detail updates are disabled (AIUpdate.LOD.Enable).");
+        return true;
+    }
+
+    static char const* tierNames[MAX_AI_UPDATE_TIERS] = { "Active", "Near", "Far", "Idle" };
+    AIUpdateStats const& tick = scheduler.GetLastTickStats();
+    AIUpdateStats const& total = scheduler.GetTotalStats();
+    PSendSysMessage("AI updates on map %u, last tick (total since map creation):", player->GetMapId());
+    for (uint32 i = 0; i < MAX_AI_UPDATE_TIERS; ++i)
+        PSendSysMessage("%s: %u units, %u updated (%u), %u deferred (%u), %u us (" UI64FMTD " us)", tierNames[i],
+            tick.tiers[i].units, tick.tiers[i].updates, total.tiers[i].updates, tick.tiers[i].deferred, total.tiers[i].deferred,
+            uint32(tick.tiers[i].timeUs), total.tiers[i].timeUs);
+    return true;
+}
+
+bool ChatHandler::HandleAutosaveStats(char* /*args*/)
+{
+    uint32 budget = sWorld.getConfig(CONFIG_UINT32_PLAYER_SAVE_STATEMENTS_PER_TICK);
+    PlayerSaveSchedulerStats stats = sPlayerSaveScheduler.GetStats();
+
+    if (budget)
+        PSendSysMessage("Autosave budget: %u statements per tick.", budget);
+    else
+        SendSysMessage("Autosave budget: none, players save as soon as their timer expires.");
+    PSendSysMessage("Autosave backlog: %u players, oldest waiting %u ms.", stats.pending, stats.oldestWait);
+    PSendSysMessage("Last tick granted %u saves (~%u statements).", stats.grantedLastTick, stats.statementsLastTick);
+    PSendSysMessage("Saves since startup: " UI64FMTD ", statements: " UI64FMTD ".", stats.totalSaves, stats.totalStatements);
+    return true;
+}
+
+bool ChatHandler::HandleOpcodeStats(char* args)
+{
+    if (ExtractLiteralArg(&args, "reset"))
+    {
+        opcodeTable.ResetStatistics();
+        SendSysMessage("Opcode statistics reset.");
+        return true;
+    }
+
+    if (!opcodeTable.IsStatisticsEnabled())
+        SendSysMessage("Opcode statistics are disabled (Network.OpcodeStats), showing what was collected before.");
+
+    uint32 limit = 20;
+    if (*args && (!ExtractUInt32(&args, limit) || !limit))
+        return false;
+
+    // most expensive opcodes first
+    std::vector<OpcodeStatisticsSummary> stats = opcodeTable.GetStatistics();
+    std::sort(stats.begin(), stats.end(), [](OpcodeStatisticsSummary const& a, OpcodeStatisticsSummary const& b) { return a.timeUs > b.timeUs; });
+    if (stats.size() > limit)
+        stats.resize(limit);
+
+    PSendSysMessage("Top %u opcodes by handler time: count, bytes, total / p50 / p99 handler time", uint32(stats.size()));
+    for (OpcodeStatisticsSummary const& opcode : stats)
+        PSendSysMessage("%s: " UI64FMTD ", " UI64FMTD " bytes, " UI64FMTD " us / <%u us / <%u us", opcodeTable[opcode.opcode].name,
+            opcode.count, opcode.bytes, opcode.timeUs, opcode.p50Us, opcode.p99Us);
+    return true;
+}
+
+bool ChatHandler::HandleDbScriptQueueStats(char* /*args*/)
+{
+    Player* player = m_session->GetPlayer();
+    if (!player)
+        return false;
+
+    ScriptActionQueueStats stats = player->GetMap()->GetScriptScheduleStats();
+    PSendSysMessage("DB script steps on map %u: %u pending in %u time buckets.", player->GetMapId(), stats.pending, stats.buckets);
+    PSendSysMessage("Since map creation: " UI64FMTD " executed, " UI64FMTD " cancelled by terminated scripts.", stats.executed, stats.cancelled);
+    return true;
+}
+
+bool ChatHandler::HandleMapMemoryStats(char* /*args*/)
+{
+    uint32 maps = 0;
+    uint64 totalBytes = 0;
+    sMapMgr.DoForAllMaps([&](Map* map)
+    {
+        MapMemoryStats stats = map->GetMemoryStats();
+        PSendSysMessage("Map %u instance %u: %u grids (" UI64FMTD " KB), %u objects (at least " UI64FMTD " KB), %u dynamic models, %u spawn groups, %u players, tick arena " UI64FMTD " KB (" UI64FMTD " heap allocations)",
+            map->GetId(), map->GetInstanceId(), stats.grids, stats.gridBytes / 1024, stats.objects, stats.objectBytes / 1024, stats.dynamicModels, stats.spawnGroups, stats.players,
+            stats.tickArenaBytes / 1024, stats.tickArenaUpstreamAllocations);
+        totalBytes += stats.gridBytes + stats.objectBytes + stats.tickArenaBytes;
+        ++maps;
+    });
+    PSendSysMessage("%u maps, at least " UI64FMTD " KB of grids, objects and tick arenas. Not counted: players, memory the objects allocate themselves, terrain, spawn data and scripts shared per map id.", maps, totalBytes / 1024);
+    return true;
+}
+
 bool ChatHandler::HandleDebugWaypoint(char* args)
 {
     Creature* target = getSelectedCreature();
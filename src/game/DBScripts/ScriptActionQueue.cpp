@@ -0,0 +1,128 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "DBScripts/ScriptActionQueue.h"
+
+ScriptActionQueue::ScriptActionQueue() : m_dispatching(nullptr), m_pending(0), m_executed(0), m_cancelled(0)
+{
+}
+
+void ScriptActionQueue::Schedule(TimePoint const& when, ScriptAction const& action)
+{
+    auto itr = m_buckets.lower_bound(when);
+    if (itr == m_buckets.end() || itr->first != when)
+    {
+        if (!m_freeBuckets.empty())
+        {
+            BucketMap::node_type node = std::move(m_freeBuckets.back());
+            m_freeBuckets.pop_back();
+            node.key() = when;
+            itr = m_buckets.insert(itr, std::move(node));
+        }
+        else
+            itr = m_buckets.emplace_hint(itr, when, Bucket());
+    }
+
+    itr->second.emplace_back(action);
+    ++m_pending;
+}
+
+void ScriptActionQueue::Process(TimePoint const& now)
+{
+    while (!m_buckets.empty() && m_buckets.begin()->first <= now)
+    {
+        // take the bucket out before running it: a step scheduled with delay 0 by a running one gets the same
+        // time key, it lands in a new bucket instead of growing the vector we walk and runs in a later iteration
+        BucketMap::node_type node = m_buckets.extract(m_buckets.begin());
+        m_dispatching = &node.mapped();
+
+        for (Entry& entry : node.mapped())
+        {
+            if (entry.done)
+                continue;
+
+            // still pending while it runs, so unique starts of its own script see it
+            bool terminate = entry.action.HandleScriptStep();
+            entry.done = true;
+            --m_pending;
+            ++m_executed;
+
+            if (terminate)
+                Cancel(entry.action.GetTableName(), entry.action.GetId(), entry.action.GetSourceGuid(), entry.action.GetTargetGuid(), entry.action.GetOwnerGuid());
+        }
+
+        m_dispatching = nullptr;
+        if (m_freeBuckets.size() < SCRIPT_QUEUE_FREE_BUCKETS)
+        {
+            node.mapped().clear();
+            m_freeBuckets.push_back(std::move(node));
+        }
+    }
+}
+
+bool ScriptActionQueue::HasScript(char const* table, uint32 id, ObjectGuid sourceGuid, ObjectGuid targetGuid, ObjectGuid ownerGuid) const
+{
+    auto isSame = [&](Bucket const& bucket)
+    {
+        for (Entry const& entry : bucket)
+            if (!entry.done && entry.action.IsSameScript(table, id, sourceGuid, targetGuid, ownerGuid))
+                return true;
+        return false;
+    };
+
+    if (m_dispatching && isSame(*m_dispatching))
+        return true;
+
+    for (auto const& bucket : m_buckets)
+        if (isSame(bucket.second))
+            return true;
+
+    return false;
+}
+
+void ScriptActionQueue::Cancel(char const* table, uint32 id, ObjectGuid sourceGuid, ObjectGuid targetGuid, ObjectGuid ownerGuid)
+{
+    if (m_dispatching)
+        Cancel(*m_dispatching, table, id, sourceGuid, targetGuid, ownerGuid);
+
+    for (auto& bucket : m_buckets)
+        Cancel(bucket.second, table, id, sourceGuid, targetGuid, ownerGuid);
+}
+
+void ScriptActionQueue::Cancel(Bucket& bucket, char const* table, uint32 id, ObjectGuid sourceGuid, ObjectGuid targetGuid, ObjectGuid ownerGuid)
+{
+    for (Entry& entry : bucket)
+    {
+        if (entry.done || !entry.action.IsSameScript(table, id, sourceGuid, targetGuid, ownerGuid))
+            continue;
+
+        entry.done = true;
+        --m_pending;
+        ++m_cancelled;
+    }
+}
+
+ScriptActionQueueStats ScriptActionQueue::GetStats() const
+{
+    ScriptActionQueueStats stats;
+    stats.pending = m_pending;
+    stats.buckets = uint32(m_buckets.size());
+    stats.executed = m_executed;
+    stats.cancelled = m_cancelled;
+    return stats;
+}
@@ -0,0 +1,85 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_SCRIPT_ACTION_QUEUE_H
+#define MANGOS_SCRIPT_ACTION_QUEUE_H
+
+#include "Common.h"
+#include "DBScripts/ScriptMgr.h"
+
+#include <map>
+#include <vector>
+
+#define SCRIPT_QUEUE_FREE_BUCKETS 32                        // emptied buckets kept for reuse
+
+struct ScriptActionQueueStats
+{
+    uint32 pending;                                         // steps waiting for their time
+    uint32 buckets;                                         // distinct times they wait for
+    uint64 executed;                                        // steps run since map creation
+    uint64 cancelled;                                       // steps dropped because their script terminated
+};
+
+/**
+ * Delayed DB script steps of one map, grouped by the time they are due.
+ *
+ * All steps due at the same time share one bucket, a script started on hundreds of sources costs
+ * one tree node per distinct delay instead of one per step. Dispatched buckets keep their node
+ * and storage for the next schedule. Steps of a bucket run in the order they were scheduled.
+ * Terminating a script only marks its pending steps, they are skipped when their bucket is due.
+ */
+class ScriptActionQueue
+{
+    public:
+        ScriptActionQueue();
+
+        void Schedule(TimePoint const& when, ScriptAction const& action);
+        // runs all steps due until now, a step returning true terminates the pending steps of its script
+        void Process(TimePoint const& now);
+
+        bool IsEmpty() const { return m_buckets.empty(); }
+        // empty guids match any
+        bool HasScript(char const* table, uint32 id, ObjectGuid sourceGuid, ObjectGuid targetGuid, ObjectGuid ownerGuid) const;
+
+        ScriptActionQueueStats GetStats() const;
+
+    private:
+        struct Entry
+        {
+            explicit Entry(ScriptAction const& _action) : action(_action), done(false) {}
+
+            ScriptAction action;
+            bool done;                                      // executed or cancelled
+        };
+
+        typedef std::vector<Entry> Bucket;
+        typedef std::map<TimePoint, Bucket> BucketMap;
+
+        void Cancel(char const* table, uint32 id, ObjectGuid sourceGuid, ObjectGuid targetGuid, ObjectGuid ownerGuid);
+        void Cancel(Bucket& bucket, char const* table, uint32 id, ObjectGuid sourceGuid, ObjectGuid targetGuid, ObjectGuid ownerGuid);
+
+        BucketMap m_buckets;
+        std::vector<BucketMap::node_type> m_freeBuckets;
+        Bucket* m_dispatching;                              // bucket taken out of m_buckets while its steps run
+
+        uint32 m_pending;
+        uint64 m_executed;
+        uint64 m_cancelled;
+};
+
+#endif
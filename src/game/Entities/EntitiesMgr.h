@@ -21,6 +21,7 @@
 
 #include "Common.h"
 #include <memory>
+#include <memory_resource>
 #include "ObjectGuid.h"
 #include "Util/Timer.h"
 
@@ -41,7 +42,7 @@ struct GameObjectData;
 
 typedef std::list<WorldObject*> WorldObjectList;
 typedef std::set<WorldObject*> WorldObjectSet;
-typedef std::unordered_set<WorldObject*> WorldObjectUnSet;
+typedef std::pmr::unordered_set<WorldObject*> WorldObjectUnSet;  // Map::Update builds it in the per tick arena of the map
 typedef std::list<Unit*> UnitList;
 typedef std::list<Creature*> CreatureList;
 typedef std::list<GameObject*> GameObjectList;
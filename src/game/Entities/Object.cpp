@@ -195,6 +195,12 @@ void Object::BuildCreateUpdateBlockForPlayer(UpdateData* data, Player* target) c
 
 void Object::SendCreateUpdateToPlayer(Player* player) const
 {
+    if (!player->GetSession()->WantsObjectUpdates())
+    {
+        sWorld.IncrementSkippedUpdateBlocks();
+        return;
+    }
+
     // send create update to player
     UpdateData updateData;
     BuildCreateUpdateBlockForPlayer(&updateData, player);
@@ -2543,10 +2549,7 @@ struct WorldObjectChangeAccumulator
     {
         // send self fields changes in another way, otherwise
         // with new camera system when player's camera too far from player, camera wouldn't receive packets and changes from player
-        if (i_object.isType(TYPEMASK_PLAYER))
-#ifdef ENABLE_PLAYERBOTS
-            if (((Player*)&i_object)->isRealPlayer())
-#endif
+        if (i_object.isType(TYPEMASK_PLAYER) && ((Player*)&i_object)->GetSession()->WantsObjectUpdates())
             i_object.BuildUpdateDataForPlayer((Player*)&i_object, i_updateDatas);
     }
 
@@ -2555,12 +2558,16 @@ struct WorldObjectChangeAccumulator
         for (auto& iter : m)
         {
             Player* owner = iter.getSource()->GetOwner();
-#ifdef ENABLE_PLAYERBOTS
-            if (owner != &i_object && owner->isRealPlayer() && owner->HasAtClient(&i_object))
-#else
             if (owner != &i_object && owner->HasAtClient(&i_object))
-#endif
+            {
+                // nobody reads object updates of socketless sessions, only keep client visibility data for them
+                if (!owner->GetSession()->WantsObjectUpdates())
+                {
+                    sWorld.IncrementSkippedUpdateBlocks();
+                    continue;
+                }
                 i_object.BuildUpdateDataForPlayer(owner, i_updateDatas);
+            }
         }
     }
 
@@ -114,7 +114,7 @@ class GenericTransport;
 class ElunaEventProcessor;
 #endif
 
-typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
+typedef std::pmr::unordered_map<Player*, UpdateData> UpdateDataMapType;
 
 class CooldownData
 {
@@ -60,6 +60,7 @@
 #include "Server/SQLStorages.h"
 #include "Loot/LootMgr.h"
 #include "World/WorldState.h"
+#include "World/PlayerSaveScheduler.h"
 #include "Anticheat/Anticheat.hpp"
 #ifdef _WIN32
 #include "AI/ScriptDevAI/scripts/custom/Transmogrification.h"
@@ -70,6 +71,10 @@
 #include "LuaEngine/LuaEngine.h"
 #endif
 
+#ifdef BUILD_METRICS
+ #include "Metric/Metric.h"
+#endif
+
 #ifdef BUILD_PLAYERBOT
 #include "PlayerBot/Base/PlayerbotAI.h"
 #include "PlayerBot/Base/PlayerbotMgr.h"
@@ -545,6 +550,8 @@ Player::Player(WorldSession* session): Unit(), m_taxiTracker(*this), m_mover(thi
     // randomize first save time in range [CONFIG_UINT32_INTERVAL_SAVE] around [CONFIG_UINT32_INTERVAL_SAVE]
     // this must help in case next save after mass player load after server startup
     m_nextSave = urand(m_nextSave / 2, m_nextSave * 3 / 2);
+    m_autosavePending = false;
+    m_lastSaveStatements = 0;
 
     clearResurrectRequestData();
 
@@ -586,6 +593,13 @@ Player::Player(WorldSession* session): Unit(), m_taxiTracker(*this), m_mover(thi
 
     m_WeeklyQuestChanged = false;
 
+    m_characterRowSaved = false;
+    m_hasSavedAuras = true;                                 // unknown until the first save
+    m_spellCooldownsSaved = false;
+    m_specNamesChanged = false;
+    m_forgottenSkillsChanged = false;
+    m_enteredInstancesChanged = false;
+
     m_lastLiquid = nullptr;
 
     m_drunkTimer = 0;
@@ -1575,9 +1589,21 @@ void Player::Update(const uint32 diff)
     {
         if (diff >= m_nextSave)
         {
-            // m_nextSave reseted in SaveToDB call
-            SaveToDB();
-            DETAIL_LOG("Player '%s' (GUID: %u) saved", GetName(), GetGUIDLow());
+            // with a save budget wait for the scheduler to grant the save
+            if (sPlayerSaveScheduler.IsEnabled())
+            {
+                if (!m_autosavePending)
+                {
+                    m_autosavePending = true;
+                    sPlayerSaveScheduler.RequestSave(this);
+                }
+            }
+            else
+            {
+                // m_nextSave reseted in SaveToDB call
+                SaveToDB();
+                DETAIL_LOG("Player '%s' (GUID: %u) saved", GetName(), GetGUIDLow());
+            }
         }
         else
             m_nextSave -= diff;
@@ -1660,7 +1686,21 @@ void Player::Update(const uint32 diff)
 
 #ifdef BUILD_PLAYERBOT
     if (m_playerbotAI)
-        m_playerbotAI->UpdateAI(diff);
+    {
+        // may have been far teleported above
+        if (!IsInWorld())
+            m_playerbotAI->UpdateAI(diff);
+        else
+        {
+            uint32 aiDiff = diff;
+            AIUpdateScheduler& scheduler = GetMap()->GetAIUpdateScheduler();
+            if (scheduler.ShouldUpdateAI(this, aiDiff))
+            {
+                AIUpdateTimeGuard aiTime(scheduler, m_aiUpdateState.tier);
+                m_playerbotAI->UpdateAI(aiDiff);
+            }
+        }
+    }
     else if (m_playerbotMgr)
         m_playerbotMgr->UpdateAI(diff);
 #endif
@@ -2225,9 +2265,14 @@ void Player::SetSemaphoreTeleportNear(bool semphsetting)
 
 void Player::SetSemaphoreTeleportFar(bool semphsetting)
 {
-    m_semaphoreTeleport_Far = semphsetting;
-    if (!semphsetting)
+    // anything queued for the map thread from the start of a far teleport until its ack was meant for the old map,
+    // a near teleport keeps the queue and only loses the movement packets
+    if (semphsetting || m_semaphoreTeleport_Far)
+        GetSession()->ClearMapPackets();
+    else
         GetSession()->DeleteMovementPackets();
+
+    m_semaphoreTeleport_Far = semphsetting;
 }
 
 void Player::ProcessDelayedOperations()
@@ -3827,13 +3872,8 @@ void Player::_LoadSpellCooldowns(QueryResult* result)
 
 void Player::_SaveSpellCooldowns()
 {
-    static SqlStatementID deleteSpellCooldown;
-
-    // delete all old cooldown
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM character_spell_cooldown WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
-
-    static SqlStatementID insertSpellCooldown;
+    std::vector<SavedSpellCooldown> cooldowns;
+    cooldowns.reserve(m_cooldownMap.size());
 
     for (auto& cdItr : m_cooldownMap)
     {
@@ -3844,19 +3884,43 @@ void Player::_SaveSpellCooldowns()
             TimePoint cTime = TimePoint::min();
             cdData->GetSpellCDExpireTime(sTime);
             cdData->GetCatCDExpireTime(cTime);
-            uint64 spellExpireTime = uint64(Clock::to_time_t(sTime));
-            uint64 catExpireTime = uint64(Clock::to_time_t(cTime));
 
-            stmt = CharacterDatabase.CreateStatement(insertSpellCooldown, "INSERT INTO character_spell_cooldown (guid, SpellId, SpellExpireTime, Category, CategoryExpireTime, ItemId) VALUES( ?, ?, ?, ?, ?, ?)");
-            stmt.addUInt32(GetGUIDLow());
-            stmt.addUInt32(cdData->GetSpellId());
-            stmt.addUInt64(spellExpireTime);
-            stmt.addUInt32(cdData->GetCategory());
-            stmt.addUInt64(catExpireTime);
-            stmt.addUInt32(cdData->GetItemId());
-            stmt.Execute();
+            SavedSpellCooldown cooldown;
+            cooldown.spellId = cdData->GetSpellId();
+            cooldown.spellExpireTime = uint64(Clock::to_time_t(sTime));
+            cooldown.category = cdData->GetCategory();
+            cooldown.catExpireTime = uint64(Clock::to_time_t(cTime));
+            cooldown.itemId = cdData->GetItemId();
+            cooldowns.push_back(cooldown);
         }
     }
+
+    // expire times are absolute, same cooldowns means same rows
+    if (m_spellCooldownsSaved && cooldowns == m_savedSpellCooldowns)
+        return;
+
+    static SqlStatementID deleteSpellCooldown;
+
+    // delete all old cooldown
+    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM character_spell_cooldown WHERE guid = ?");
+    stmt.PExecute(GetGUIDLow());
+
+    static SqlStatementID insertSpellCooldown;
+
+    for (SavedSpellCooldown const& cooldown : cooldowns)
+    {
+        stmt = CharacterDatabase.CreateStatement(insertSpellCooldown, "INSERT INTO character_spell_cooldown (guid, SpellId, SpellExpireTime, Category, CategoryExpireTime, ItemId) VALUES( ?, ?, ?, ?, ?, ?)");
+        stmt.addUInt32(GetGUIDLow());
+        stmt.addUInt32(cooldown.spellId);
+        stmt.addUInt64(cooldown.spellExpireTime);
+        stmt.addUInt32(cooldown.category);
+        stmt.addUInt64(cooldown.catExpireTime);
+        stmt.addUInt32(cooldown.itemId);
+        stmt.Execute();
+    }
+
+    m_savedSpellCooldowns.swap(cooldowns);
+    m_spellCooldownsSaved = true;
 }
 
 
@@ -6007,7 +6071,10 @@ void Player::UpdateSpellTrainedSkills(uint32 spellId, bool apply)
                         //   this talent point and return to it later.
                         if (pSkill->categoryId == SKILL_CATEGORY_WEAPON)
                             if (GetSkillValuePure(pSkill->id) > m_forgottenSkills[pSkill->id])
+                            {
                                 m_forgottenSkills[pSkill->id] = GetSkillValuePure(pSkill->id);
+                                m_forgottenSkillsChanged = true;
+                            }
 
                         SetSkill(skillId, 0, 0);
                         break;
@@ -15075,6 +15142,9 @@ bool Player::LoadFromDB(ObjectGuid guid, SqlQueryHolder* holder)
         }
     }
 
+    // row exists, saves can update it in place
+    m_characterRowSaved = true;
+
 #ifdef USE_ACHIEVEMENTS
     OnPostLoadAchievementsFromDB();
 #endif
@@ -16081,6 +16151,7 @@ void Player::SaveToDB()
     // we should assure this: ASSERT((m_nextSave != sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE)));
     // delay auto save at any saves (manual, in code, or autosave)
     m_nextSave = sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE);
+    m_autosavePending = false;
 
     // lets allow only players in world to be saved
     if (IsBeingTeleportedFar())
@@ -16102,152 +16173,216 @@ void Player::SaveToDB()
 
     UpdateHonor();
 
-    static SqlStatementID delChar ;
-    static SqlStatementID insChar ;
+    // text columns, rarely changed and by far the largest part of the row
+    std::ostringstream ss;
+    ss << m_taxi;                                   // string with TaxiMaskSize numbers
+    std::string taxiMask = ss.str();
+    ss.str(std::string());
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(delChar, "DELETE FROM characters WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
+    std::string taxiPath = m_taxiTracker.Save();
 
-    SqlStatement uberInsert = CharacterDatabase.CreateStatement(insChar, "INSERT INTO characters (guid,account,name,race,class,gender,level,xp,money,playerBytes,playerBytes2,playerFlags,"
-                              "map, position_x, position_y, position_z, orientation, "
-                              "taximask, online, cinematic, "
-                              "totaltime, leveltime, rest_bonus, logout_time, is_logout_resting, resettalents_cost, resettalents_time, "
-                              "trans_x, trans_y, trans_z, trans_o, transguid, extra_flags, stable_slots, at_login, zone, "
-                              "death_expire_time, taxi_path, "
-                              "honor_highest_rank, honor_standing, stored_honor_rating , stored_dishonorable_kills, stored_honorable_kills, "
-                              "watchedFaction, drunk, health, power1, power2, power3, "
-                              "power4, power5, exploredZones, equipmentCache, ammoId, actionBars, specCount, activeSpec, fishingSteps) "
-                              "VALUES ( ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?,"
-                              "?, ?, ?, ?, ?, "
-                              "?, ?, ?, "
-                              "?, ?, ?, ?, ?, ?, ?, "
-                              "?, ?, ?, ?, ?, ?, ?, ?, ?, "
-                              "?, ?, "
-                              "?, ?, ?, ?, ?, "
-                              "?, ?, ?, ?, ?, ?, "
-                              "?, ?, ?, ?, ?, ?, ?, ?, ?) ");
-
-    uberInsert.addUInt32(GetGUIDLow());
-    uberInsert.addUInt32(GetSession()->GetAccountId());
-    uberInsert.addString(m_name);
-    uberInsert.addUInt8(getRace());
-    uberInsert.addUInt8(getClass());
-    uberInsert.addUInt8(getGender());
-    uberInsert.addUInt32(GetLevel());
-    uberInsert.addUInt32(GetUInt32Value(PLAYER_XP));
-    uberInsert.addUInt32(GetMoney());
-    uberInsert.addUInt32(GetUInt32Value(PLAYER_BYTES));
-    uberInsert.addUInt32(GetUInt32Value(PLAYER_BYTES_2));
-    uberInsert.addUInt32(GetUInt32Value(PLAYER_FLAGS));
-
-    if (!IsBeingTeleported())
-    {
-        uberInsert.addUInt32(GetMapId());
-        uberInsert.addFloat(finiteAlways(GetPositionX()));
-        uberInsert.addFloat(finiteAlways(GetPositionY()));
-        uberInsert.addFloat(finiteAlways(GetPositionZ()));
-        uberInsert.addFloat(finiteAlways(GetOrientation()));
+    for (uint32 i = 0; i < PLAYER_EXPLORED_ZONES_SIZE; ++i) // string
+    {
+        ss << GetUInt32Value(PLAYER_EXPLORED_ZONES_1 + i) << " ";
     }
-    else
+    std::string exploredZones = ss.str();
+    ss.str(std::string());
+
+    for (uint32 i = 0; i < EQUIPMENT_SLOT_END; ++i)         // string: item id, ench (perm/temp)
+    {
+        ss << GetUInt32Value(PLAYER_VISIBLE_ITEM_1_0 + i * MAX_VISIBLE_ITEM_OFFSET) << " ";
+
+        uint32 ench1 = GetUInt32Value(PLAYER_VISIBLE_ITEM_1_0 + i * MAX_VISIBLE_ITEM_OFFSET + 1 + PERM_ENCHANTMENT_SLOT);
+        uint32 ench2 = GetUInt32Value(PLAYER_VISIBLE_ITEM_1_0 + i * MAX_VISIBLE_ITEM_OFFSET + 1 + TEMP_ENCHANTMENT_SLOT);
+        ss << uint32(MAKE_PAIR32(ench1, ench2)) << " ";
+    }
+    // 1 in tbc - 4 in wotlk
+    for (uint32 i = INVENTORY_SLOT_BAG_START; i < INVENTORY_SLOT_BAG_START + 1; ++i) // string: item id, ench (perm/temp)
     {
-        uberInsert.addUInt32(GetTeleportDest().mapid);
-        uberInsert.addFloat(finiteAlways(GetTeleportDest().coord_x));
-        uberInsert.addFloat(finiteAlways(GetTeleportDest().coord_y));
-        uberInsert.addFloat(finiteAlways(GetTeleportDest().coord_z));
-        uberInsert.addFloat(finiteAlways(GetTeleportDest().orientation));
+        ss << (m_items[i] ? m_items[i]->GetEntry() : 0) << " ";
+        ss << uint32(MAKE_PAIR32(0, 0)) << " ";
     }
+    std::string equipmentCache = ss.str();
 
-    std::ostringstream ss;
-    ss << m_taxi;                                   // string with TaxiMaskSize numbers
-    uberInsert.addString(ss);
+    std::string blobs = taxiMask + '\n' + taxiPath + '\n' + exploredZones + '\n' + equipmentCache;
 
-    uberInsert.addUInt32(IsInWorld() ? 1 : 0);
+    // every column except guid and the text ones, in the order both statements below expect them
+    auto addCharacterColumns = [&](SqlStatement& stmt)
+    {
+        stmt.addUInt32(GetSession()->GetAccountId());
+        stmt.addString(m_name);
+        stmt.addUInt8(getRace());
+        stmt.addUInt8(getClass());
+        stmt.addUInt8(getGender());
+        stmt.addUInt32(GetLevel());
+        stmt.addUInt32(GetUInt32Value(PLAYER_XP));
+        stmt.addUInt32(GetMoney());
+        stmt.addUInt32(GetUInt32Value(PLAYER_BYTES));
+        stmt.addUInt32(GetUInt32Value(PLAYER_BYTES_2));
+        stmt.addUInt32(GetUInt32Value(PLAYER_FLAGS));
 
-    uberInsert.addUInt32(m_cinematic);
+        if (!IsBeingTeleported())
+        {
+            stmt.addUInt32(GetMapId());
+            stmt.addFloat(finiteAlways(GetPositionX()));
+            stmt.addFloat(finiteAlways(GetPositionY()));
+            stmt.addFloat(finiteAlways(GetPositionZ()));
+            stmt.addFloat(finiteAlways(GetOrientation()));
+        }
+        else
+        {
+            stmt.addUInt32(GetTeleportDest().mapid);
+            stmt.addFloat(finiteAlways(GetTeleportDest().coord_x));
+            stmt.addFloat(finiteAlways(GetTeleportDest().coord_y));
+            stmt.addFloat(finiteAlways(GetTeleportDest().coord_z));
+            stmt.addFloat(finiteAlways(GetTeleportDest().orientation));
+        }
 
-    uberInsert.addUInt32(m_Played_time[PLAYED_TIME_TOTAL]);
-    uberInsert.addUInt32(m_Played_time[PLAYED_TIME_LEVEL]);
+        stmt.addUInt32(IsInWorld() ? 1 : 0);
 
-    uberInsert.addFloat(finiteAlways(m_rest_bonus));
-    uberInsert.addUInt64(uint64(time(nullptr)));
-    uberInsert.addUInt32(HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_RESTING) ? 1 : 0);
-    // save, far from tavern/city
-    // save, but in tavern/city
-    uberInsert.addUInt32(m_resetTalentsCost);
-    uberInsert.addUInt64(uint64(m_resetTalentsTime));
+        stmt.addUInt32(m_cinematic);
 
-    Position const& transportPosition = m_movementInfo.GetTransportPos();
-    uberInsert.addFloat(finiteAlways(transportPosition.x));
-    uberInsert.addFloat(finiteAlways(transportPosition.y));
-    uberInsert.addFloat(finiteAlways(transportPosition.z));
-    uberInsert.addFloat(finiteAlways(transportPosition.o));
+        stmt.addUInt32(m_Played_time[PLAYED_TIME_TOTAL]);
+        stmt.addUInt32(m_Played_time[PLAYED_TIME_LEVEL]);
 
-    if (m_transport)
-        uberInsert.addUInt32(m_transport->GetGUIDLow());
-    else
-        uberInsert.addUInt32(0);
+        stmt.addFloat(finiteAlways(m_rest_bonus));
+        stmt.addUInt64(uint64(time(nullptr)));
+        stmt.addUInt32(HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_RESTING) ? 1 : 0);
+        // save, far from tavern/city
+        // save, but in tavern/city
+        stmt.addUInt32(m_resetTalentsCost);
+        stmt.addUInt64(uint64(m_resetTalentsTime));
 
-    uberInsert.addUInt32(m_ExtraFlags);
+        Position const& transportPosition = m_movementInfo.GetTransportPos();
+        stmt.addFloat(finiteAlways(transportPosition.x));
+        stmt.addFloat(finiteAlways(transportPosition.y));
+        stmt.addFloat(finiteAlways(transportPosition.z));
+        stmt.addFloat(finiteAlways(transportPosition.o));
 
-    uberInsert.addUInt32(uint32(m_stableSlots));            // to prevent save uint8 as char
+        if (m_transport)
+            stmt.addUInt32(m_transport->GetGUIDLow());
+        else
+            stmt.addUInt32(0);
 
-    uberInsert.addUInt32(uint32(m_atLoginFlags));
+        stmt.addUInt32(m_ExtraFlags);
 
-    uberInsert.addUInt32(IsInWorld() ? GetZoneId() : GetCachedZoneId());
+        stmt.addUInt32(uint32(m_stableSlots));              // to prevent save uint8 as char
 
-    uberInsert.addUInt64(uint64(m_deathExpireTime));
+        stmt.addUInt32(uint32(m_atLoginFlags));
 
-    ss << m_taxiTracker.Save();
-    uberInsert.addString(ss);
+        stmt.addUInt32(IsInWorld() ? GetZoneId() : GetCachedZoneId());
 
-    uberInsert.addUInt32(uint32(m_highest_rank.rank));
-    uberInsert.addInt32(m_standing_pos);
-    uberInsert.addFloat(finiteAlways(m_stored_honor));
-    uberInsert.addUInt32(m_stored_dishonorableKills);
-    uberInsert.addUInt32(m_stored_honorableKills);
+        stmt.addUInt64(uint64(m_deathExpireTime));
 
-    // FIXME: at this moment send to DB as unsigned, including unit32(-1)
-    uberInsert.addUInt32(GetUInt32Value(PLAYER_FIELD_WATCHED_FACTION_INDEX));
+        stmt.addUInt32(uint32(m_highest_rank.rank));
+        stmt.addInt32(m_standing_pos);
+        stmt.addFloat(finiteAlways(m_stored_honor));
+        stmt.addUInt32(m_stored_dishonorableKills);
+        stmt.addUInt32(m_stored_honorableKills);
 
-    uberInsert.addUInt16(uint16(GetUInt32Value(PLAYER_BYTES_3) & 0xFFFE));
+        // FIXME: at this moment send to DB as unsigned, including unit32(-1)
+        stmt.addUInt32(GetUInt32Value(PLAYER_FIELD_WATCHED_FACTION_INDEX));
 
-    uberInsert.addUInt32(GetHealth());
+        stmt.addUInt16(uint16(GetUInt32Value(PLAYER_BYTES_3) & 0xFFFE));
 
-    for (uint32 i = 0; i < MAX_POWERS; ++i)
-        uberInsert.addUInt32(GetPower(Powers(i)));
+        stmt.addUInt32(GetHealth());
 
-    for (uint32 i = 0; i < PLAYER_EXPLORED_ZONES_SIZE; ++i) // string
-    {
-        ss << GetUInt32Value(PLAYER_EXPLORED_ZONES_1 + i) << " ";
-    }
-    uberInsert.addString(ss);
+        for (uint32 i = 0; i < MAX_POWERS; ++i)
+            stmt.addUInt32(GetPower(Powers(i)));
 
-    for (uint32 i = 0; i < EQUIPMENT_SLOT_END; ++i)         // string: item id, ench (perm/temp)
-    {
-        ss << GetUInt32Value(PLAYER_VISIBLE_ITEM_1_0 + i * MAX_VISIBLE_ITEM_OFFSET) << " ";
+        stmt.addUInt32(GetUInt32Value(PLAYER_AMMO_ID));
 
-        uint32 ench1 = GetUInt32Value(PLAYER_VISIBLE_ITEM_1_0 + i * MAX_VISIBLE_ITEM_OFFSET + 1 + PERM_ENCHANTMENT_SLOT);
-        uint32 ench2 = GetUInt32Value(PLAYER_VISIBLE_ITEM_1_0 + i * MAX_VISIBLE_ITEM_OFFSET + 1 + TEMP_ENCHANTMENT_SLOT);
-        ss << uint32(MAKE_PAIR32(ench1, ench2)) << " ";
-    }
-    // 1 in tbc - 4 in wotlk
-    for (uint32 i = INVENTORY_SLOT_BAG_START; i < INVENTORY_SLOT_BAG_START + 1; ++i) // string: item id, ench (perm/temp)
-    {
-        ss << (m_items[i] ? m_items[i]->GetEntry() : 0) << " ";
-        ss << uint32(MAKE_PAIR32(0, 0)) << " ";
-    }
-    uberInsert.addString(ss);
+        stmt.addUInt32(uint32(GetByteValue(PLAYER_FIELD_BYTES, 2)));
 
-    uberInsert.addUInt32(GetUInt32Value(PLAYER_AMMO_ID));
+        stmt.addUInt32(uint32(m_specsCount));
+        stmt.addUInt32(uint32(m_activeSpec));
 
-    uberInsert.addUInt32(uint32(GetByteValue(PLAYER_FIELD_BYTES, 2)));
+        stmt.addUInt8(m_fishingSteps);
+    };
 
-    uberInsert.addUInt32(uint32(m_specsCount));
-    uberInsert.addUInt32(uint32(m_activeSpec));
+    auto addBlobColumns = [&](SqlStatement& stmt)
+    {
+        stmt.addString(taxiMask);
+        stmt.addString(taxiPath);
+        stmt.addString(exploredZones);
+        stmt.addString(equipmentCache);
+    };
 
-    uberInsert.addUInt8(m_fishingSteps);
+    static SqlStatementID delChar ;
+    static SqlStatementID insChar ;
+    static SqlStatementID updChar ;
+    static SqlStatementID updCharNoText ;
+
+    if (!m_characterRowSaved)
+    {
+        SqlStatement stmt = CharacterDatabase.CreateStatement(delChar, "DELETE FROM characters WHERE guid = ?");
+        stmt.PExecute(GetGUIDLow());
+
+        SqlStatement uberInsert = CharacterDatabase.CreateStatement(insChar, "INSERT INTO characters (guid,account,name,race,class,gender,level,xp,money,playerBytes,playerBytes2,playerFlags,"
+                                  "map, position_x, position_y, position_z, orientation, "
+                                  "online, cinematic, "
+                                  "totaltime, leveltime, rest_bonus, logout_time, is_logout_resting, resettalents_cost, resettalents_time, "
+                                  "trans_x, trans_y, trans_z, trans_o, transguid, extra_flags, stable_slots, at_login, zone, "
+                                  "death_expire_time, "
+                                  "honor_highest_rank, honor_standing, stored_honor_rating , stored_dishonorable_kills, stored_honorable_kills, "
+                                  "watchedFaction, drunk, health, power1, power2, power3, "
+                                  "power4, power5, ammoId, actionBars, specCount, activeSpec, fishingSteps, "
+                                  "taximask, taxi_path, exploredZones, equipmentCache) "
+                                  "VALUES ( ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?,"
+                                  "?, ?, ?, ?, ?, "
+                                  "?, ?, "
+                                  "?, ?, ?, ?, ?, ?, ?, "
+                                  "?, ?, ?, ?, ?, ?, ?, ?, ?, "
+                                  "?, "
+                                  "?, ?, ?, ?, ?, "
+                                  "?, ?, ?, ?, ?, ?, "
+                                  "?, ?, ?, ?, ?, ?, ?, "
+                                  "?, ?, ?, ?) ");
+
+        uberInsert.addUInt32(GetGUIDLow());
+        addCharacterColumns(uberInsert);
+        addBlobColumns(uberInsert);
+        uberInsert.Execute();
+    }
+    else if (blobs != m_savedCharacterBlobs)
+    {
+        SqlStatement uberUpdate = CharacterDatabase.CreateStatement(updChar, "UPDATE characters SET account = ?, name = ?, race = ?, class = ?, gender = ?, level = ?, xp = ?, money = ?, playerBytes = ?, playerBytes2 = ?, playerFlags = ?, "
+                                  "map = ?, position_x = ?, position_y = ?, position_z = ?, orientation = ?, "
+                                  "online = ?, cinematic = ?, "
+                                  "totaltime = ?, leveltime = ?, rest_bonus = ?, logout_time = ?, is_logout_resting = ?, resettalents_cost = ?, resettalents_time = ?, "
+                                  "trans_x = ?, trans_y = ?, trans_z = ?, trans_o = ?, transguid = ?, extra_flags = ?, stable_slots = ?, at_login = ?, zone = ?, "
+                                  "death_expire_time = ?, "
+                                  "honor_highest_rank = ?, honor_standing = ?, stored_honor_rating = ?, stored_dishonorable_kills = ?, stored_honorable_kills = ?, "
+                                  "watchedFaction = ?, drunk = ?, health = ?, power1 = ?, power2 = ?, power3 = ?, "
+                                  "power4 = ?, power5 = ?, ammoId = ?, actionBars = ?, specCount = ?, activeSpec = ?, fishingSteps = ?, "
+                                  "taximask = ?, taxi_path = ?, exploredZones = ?, equipmentCache = ? "
+                                  "WHERE guid = ?");
+
+        addCharacterColumns(uberUpdate);
+        addBlobColumns(uberUpdate);
+        uberUpdate.addUInt32(GetGUIDLow());
+        uberUpdate.Execute();
+    }
+    else
+    {
+        SqlStatement uberUpdate = CharacterDatabase.CreateStatement(updCharNoText, "UPDATE characters SET account = ?, name = ?, race = ?, class = ?, gender = ?, level = ?, xp = ?, money = ?, playerBytes = ?, playerBytes2 = ?, playerFlags = ?, "
+                                  "map = ?, position_x = ?, position_y = ?, position_z = ?, orientation = ?, "
+                                  "online = ?, cinematic = ?, "
+                                  "totaltime = ?, leveltime = ?, rest_bonus = ?, logout_time = ?, is_logout_resting = ?, resettalents_cost = ?, resettalents_time = ?, "
+                                  "trans_x = ?, trans_y = ?, trans_z = ?, trans_o = ?, transguid = ?, extra_flags = ?, stable_slots = ?, at_login = ?, zone = ?, "
+                                  "death_expire_time = ?, "
+                                  "honor_highest_rank = ?, honor_standing = ?, stored_honor_rating = ?, stored_dishonorable_kills = ?, stored_honorable_kills = ?, "
+                                  "watchedFaction = ?, drunk = ?, health = ?, power1 = ?, power2 = ?, power3 = ?, "
+                                  "power4 = ?, power5 = ?, ammoId = ?, actionBars = ?, specCount = ?, activeSpec = ?, fishingSteps = ? "
+                                  "WHERE guid = ?");
 
-    uberInsert.Execute();
+        addCharacterColumns(uberUpdate);
+        uberUpdate.addUInt32(GetGUIDLow());
+        uberUpdate.Execute();
+    }
+
+    m_characterRowSaved = true;
+    m_savedCharacterBlobs.swap(blobs);
 
     if (m_mailsUpdated)                                     // save mails only when needed
         _SaveMail();
@@ -16272,6 +16407,13 @@ void Player::SaveToDB()
     SaveAchievementsToDB();
 #endif
 
+    m_lastSaveStatements = CharacterDatabase.GetTransactionSize();
+    sPlayerSaveScheduler.OnPlayerSaved(m_lastSaveStatements);
+#ifdef BUILD_METRICS
+    metric::measurement meas("player.save");
+    meas.add_field("statements", std::to_string(m_lastSaveStatements));
+#endif
+
     CharacterDatabase.CommitTransaction();
 
     // check if stats should only be saved on logout
@@ -16449,15 +16591,13 @@ void Player::_SaveAuras()
     static SqlStatementID deleteAuras ;
     static SqlStatementID insertAuras ;
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM character_aura WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
+    // remaining durations change all the time, so saved auras are always rewritten,
+    // but the delete is only needed when there were or will be rows
+    bool hasAuras = false;
 
     SpellAuraHolderMap const& auraHolders = GetSpellAuraHolderMap();
 
-    if (auraHolders.empty())
-        return;
-
-    stmt = CharacterDatabase.CreateStatement(insertAuras, "INSERT INTO character_aura (guid, caster_guid, item_guid, spell, stackcount, remaincharges, "
+    SqlStatement stmt = CharacterDatabase.CreateStatement(insertAuras, "INSERT INTO character_aura (guid, caster_guid, item_guid, spell, stackcount, remaincharges, "
             "basepoints0, basepoints1, basepoints2, periodictime0, periodictime1, periodictime2, maxduration, remaintime, effIndexMask) "
             "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
 
@@ -16492,6 +16632,13 @@ void Player::_SaveAuras()
             if (!effIndexMask)
                 continue;
 
+            if (!hasAuras)
+            {
+                SqlStatement stmtDel = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM character_aura WHERE guid = ?");
+                stmtDel.PExecute(GetGUIDLow());
+                hasAuras = true;
+            }
+
             stmt.addUInt32(GetGUIDLow());
             stmt.addUInt64(holder->GetCasterGuid().GetRawValue());
             stmt.addUInt32(holder->GetCastItemGuid().GetCounter());
@@ -16511,6 +16658,15 @@ void Player::_SaveAuras()
             stmt.Execute();
         }
     }
+
+    // all previously saved auras are gone
+    if (!hasAuras && m_hasSavedAuras)
+    {
+        SqlStatement stmtDel = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM character_aura WHERE guid = ?");
+        stmtDel.PExecute(GetGUIDLow());
+    }
+
+    m_hasSavedAuras = hasAuras;
 }
 
 void Player::_SaveInventory()
@@ -16828,6 +16984,11 @@ void Player::_SaveSkills()
     }
 
     // Forgotten weapon skills.
+    if (!m_forgottenSkillsChanged)
+        return;
+
+    m_forgottenSkillsChanged = false;
+
     static SqlStatementID forSkills;
 
     for (const auto itr : m_forgottenSkills)
@@ -16874,6 +17035,11 @@ void Player::_SaveTalents()
 
 void Player::_SaveTalentSpecNames()
 {
+    if (!m_specNamesChanged)
+        return;
+
+    m_specNamesChanged = false;
+
     for (uint8 i = 0; i < MAX_TALENT_SPECS; i++)
     {
         if (specNames[i] != "")
@@ -18773,7 +18939,10 @@ void Player::UpdateVisibilityOf(WorldObject const* viewPoint, T* target, UpdateD
             if (target->GetTypeId() == TYPEID_UNIT)
                 BeforeVisibilityDestroy(dynamic_cast<Creature*>(target));
 
-            target->BuildOutOfRangeUpdateBlock(&data);
+            if (GetSession()->WantsObjectUpdates())
+                target->BuildOutOfRangeUpdateBlock(&data);
+            else
+                sWorld.IncrementSkippedUpdateBlocks();
             RemoveAtClient(target);
 
             DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "UpdateVisibilityOf(TemplateV): %s is out of range for %s. Distance = %f", t_guid.GetString().c_str(), GetGuidStr().c_str(), GetDistance(target));
@@ -18784,7 +18953,10 @@ void Player::UpdateVisibilityOf(WorldObject const* viewPoint, T* target, UpdateD
         if (target->isVisibleForInState(this, viewPoint, false))
         {
             visibleNow.insert(target);
-            target->BuildCreateUpdateBlockForPlayer(&data, this);
+            if (GetSession()->WantsObjectUpdates())
+                target->BuildCreateUpdateBlockForPlayer(&data, this);
+            else
+                sWorld.IncrementSkippedUpdateBlocks();
             AddAtClient(target);
 
             DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "UpdateVisibilityOf(TemplateV): %s is visible now for %s. Distance = %f", target->GetGuidStr().c_str(), GetGuidStr().c_str(), GetDistance(target));
@@ -21322,7 +21494,10 @@ bool Player::CanEnterNewInstance(uint32 instanceId)
 void Player::AddNewInstanceId(uint32 instanceId)
 {
     if (m_enteredInstances.find(instanceId) == m_enteredInstances.end())
+    {
         m_enteredInstances.emplace(instanceId, std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now() + std::chrono::hours(1)));
+        m_enteredInstancesChanged = true;
+    }
 }
 
 void Player::_LoadCreatedInstanceTimers()
@@ -21349,6 +21524,11 @@ void Player::_LoadCreatedInstanceTimers()
 
 void Player::_SaveNewInstanceIdTimer()
 {
+    if (!m_enteredInstancesChanged)
+        return;
+
+    m_enteredInstancesChanged = false;
+
     CharacterDatabase.PExecute("DELETE FROM account_instances_entered WHERE AccountId = '%u'", m_session->GetAccountId());
 
     if (m_enteredInstances.empty())
@@ -21373,7 +21553,10 @@ void Player::UpdateNewInstanceIdTimers(TimePoint const& now)
     for (auto iter = m_enteredInstances.begin(); iter != m_enteredInstances.end();)
     {
         if ((*iter).second < now)
+        {
             iter = m_enteredInstances.erase(iter);
+            m_enteredInstancesChanged = true;
+        }
         else
             ++iter;
     }
@@ -21585,7 +21768,10 @@ void Player::SetSpecName(uint8 spec, const char* specName)
     }
 
     if (specName)
+    {
         specNames[spec] = specName;
+        m_specNamesChanged = true;
+    }
 }
 
 void Player::addTalent(uint32 spellId, uint8 spec, bool learning)
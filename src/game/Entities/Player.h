@@ -2179,6 +2179,10 @@ class Player : public Unit
         ObjectGuid const& GetFarSightGuid() const { return GetGuidValue(PLAYER_FARSIGHT); }
 
         uint32 GetSaveTimer() const { return m_nextSave; }
+        bool IsAutosavePending() const { return m_autosavePending; }
+        uint32 GetLastSaveStatements() const { return m_lastSaveStatements; }
+        // how much unsaved state the player has, autosaves of players with more go first
+        uint32 GetPendingSaveWeight() const { return uint32(m_itemUpdateQueue.size()) + (m_mailsUpdated ? 1 : 0); }
         void   SetSaveTimer(uint32 timer) { m_nextSave = timer; }
 
         // Recall position
@@ -2486,6 +2490,8 @@ class Player : public Unit
 
         Team m_team;
         uint32 m_nextSave;
+        bool m_autosavePending;                             // waiting for PlayerSaveScheduler to grant the autosave
+        uint32 m_lastSaveStatements;
         time_t m_speakTime;
         uint32 m_speakCount;
         uint32 m_atLoginFlags;
@@ -2540,6 +2546,31 @@ class Player : public Unit
 
         bool   m_WeeklyQuestChanged;
 
+        // incremental save state, lets SaveToDB skip rows that did not change since the last save
+        bool m_characterRowSaved;                           // characters row exists, updated in place
+        std::string m_savedCharacterBlobs;                  // text columns as written by the last save
+        bool m_hasSavedAuras;                               // character_aura may hold rows of this character
+        bool m_specNamesChanged;
+        bool m_forgottenSkillsChanged;
+        bool m_enteredInstancesChanged;
+
+        struct SavedSpellCooldown
+        {
+            uint32 spellId;
+            uint64 spellExpireTime;
+            uint32 category;
+            uint64 catExpireTime;
+            uint32 itemId;
+
+            bool operator==(SavedSpellCooldown const& other) const
+            {
+                return spellId == other.spellId && spellExpireTime == other.spellExpireTime && category == other.category &&
+                       catExpireTime == other.catExpireTime && itemId == other.itemId;
+            }
+        };
+        std::vector<SavedSpellCooldown> m_savedSpellCooldowns; // rows written by the last _SaveSpellCooldowns
+        bool m_spellCooldownsSaved;                         // m_savedSpellCooldowns matches the table
+
         uint32 m_drunkTimer;
         uint16 m_drunk;
 
@@ -364,6 +364,7 @@ Unit::Unit() :
     // m_AurasCheck = 2000;
     // m_removeAuraTimer = 4;
     m_spellAuraHoldersUpdateIterator = m_spellAuraHolders.end();
+    m_procAuraHoldersMask = 0;
     m_AuraFlags = 0;
 
     m_Visibility = VISIBILITY_ON;
@@ -527,17 +528,24 @@ void Unit::Update(const uint32 diff)
 
     if (AI() && IsAlive())
     {
+        // players are always updated, their AI only exists while charmed
+        uint32 aiDiff = diff;
+        AIUpdateScheduler& scheduler = GetMap()->GetAIUpdateScheduler();
+        if (GetTypeId() == TYPEID_PLAYER || scheduler.ShouldUpdateAI(this, aiDiff))
+        {
 #ifdef BUILD_METRICS
-        metric::duration<std::chrono::microseconds> meas_ai("unit.update.ai", {
-            { "entry", std::to_string(GetEntry()) },
-            { "guid", std::to_string(GetGUIDLow()) },
-            { "unit_type", std::to_string(GetGUIDHigh()) },
-            { "map_id", std::to_string(GetMapId()) },
-            { "instance_id", std::to_string(GetInstanceId()) }
-        }, 1000);
+            metric::duration<std::chrono::microseconds> meas_ai("unit.update.ai", {
+                { "entry", std::to_string(GetEntry()) },
+                { "guid", std::to_string(GetGUIDLow()) },
+                { "unit_type", std::to_string(GetGUIDHigh()) },
+                { "map_id", std::to_string(GetMapId()) },
+                { "instance_id", std::to_string(GetInstanceId()) }
+            }, 1000);
 #endif
+            AIUpdateTimeGuard aiTime(scheduler, m_aiUpdateState.tier);
 
-        AI()->UpdateAI(diff);   // AI not react good at real update delays (while freeze in non-active part of map)
+            AI()->UpdateAI(aiDiff);   // AI not react good at real update delays (while freeze in non-active part of map), skipped ticks are passed in aiDiff
+        }
     }
 
     GetCombatManager().Update(diff);
@@ -4876,6 +4884,7 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolder* holder)
     holder->_AddSpellAuraHolder();
     holder->SetCreationDelayFlag();
     m_spellAuraHolders.insert(SpellAuraHolderMap::value_type(holder->GetId(), holder));
+    AddProcAuraHolder(holder);
 
     for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
         if (Aura* aur = holder->GetAuraByEffectIndex(SpellEffectIndex(i)))
@@ -5374,6 +5383,7 @@ void Unit::RemoveSpellAuraHolder(SpellAuraHolder* holder, AuraRemoveMode mode)
             break;
         }
     }
+    RemoveProcAuraHolder(holder);
 
     holder->SetRemoveMode(mode);
     holder->UnregisterAndCleanupTrackedAuras();
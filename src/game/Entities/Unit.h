@@ -47,6 +47,7 @@
 #include "Spells/SpellDefines.h"
 #include "PlayerDefines.h"
 #include "Maps/SpawnGroupDefines.h"
+#include "Maps/AIUpdateScheduler.h"
 
 #include <list>
 #include <array>
@@ -1074,6 +1075,13 @@ class Unit : public WorldObject
         typedef std::pair<SpellAuraHolderMap::iterator, SpellAuraHolderMap::iterator> SpellAuraHolderBounds;
         typedef std::pair<SpellAuraHolderMap::const_iterator, SpellAuraHolderMap::const_iterator> SpellAuraHolderConstBounds;
         typedef std::list<SpellAuraHolder*> SpellAuraHolderList;
+        struct ProcAuraHolderEntry
+        {
+            ProcAuraHolderEntry(uint32 _procFlags, SpellAuraHolder* _holder) : procFlags(_procFlags), holder(_holder) {}
+            uint32 procFlags;                               // effective proc flags (spell_proc_event override or spell proto)
+            SpellAuraHolder* holder;
+        };
+        typedef std::vector<ProcAuraHolderEntry> ProcAuraHolderList;
         typedef std::list<Aura*> AuraList;
         typedef std::list<DiminishingReturn> Diminishing;
         typedef std::set<uint32 /*playerGuidLow*/> ComboPointHolderSet;
@@ -2190,6 +2198,9 @@ class Unit : public WorldObject
         };
 
         SpellProcEventTriggerCheck IsTriggeredAtSpellProcEvent(ProcExecutionData& data, SpellAuraHolder* holder, SpellProcEventEntry const*& spellProcEvent);
+        // proc flag index of holders that can proc at all, kept in m_spellAuraHolders order
+        void AddProcAuraHolder(SpellAuraHolder* holder);
+        void RemoveProcAuraHolder(SpellAuraHolder* holder);
         // only to be used in proc handlers - basepoints is expected to be a MAX_EFFECT_INDEX sized array
         SpellAuraProcResult TriggerProccedSpell(Unit* target, std::array<int32, MAX_EFFECT_INDEX>& basepoints, uint32 triggeredSpellId, Item* castItem, Aura* triggeredByAura, uint32 cooldown, ObjectGuid originalCaster);
         SpellAuraProcResult TriggerProccedSpell(Unit* target, std::array<int32, MAX_EFFECT_INDEX>& basepoints, SpellEntry const* spellInfo, Item* castItem, Aura* triggeredByAura, uint32 cooldown, ObjectGuid originalCaster);
@@ -2397,6 +2408,7 @@ class Unit : public WorldObject
         virtual uint32 GetDetectionRange() const { return 18.f; }
 
         virtual UnitAI* AI() { return nullptr; }
+        AIUpdateState& GetAIUpdateState() { return m_aiUpdateState; }
         virtual CombatData* GetCombatData() { return m_combatData; }
         virtual CombatData const* GetCombatData() const { return m_combatData; }
 
@@ -2488,6 +2500,9 @@ class Unit : public WorldObject
 
         SpellAuraHolderMap m_spellAuraHolders;
         SpellAuraHolderMap::iterator m_spellAuraHoldersUpdateIterator; // != end() in Unit::m_spellAuraHolders update and point to next element
+        ProcAuraHolderList m_procAuraHolders;               // subset of m_spellAuraHolders with non zero proc flags
+        uint32 m_procAuraHoldersMask;                       // union of all proc flags in m_procAuraHolders
+        AIUpdateState m_aiUpdateState;                      // level of detail scheduling of AI()->UpdateAI, see AIUpdateScheduler
         AuraList m_deletedAuras;                            // auras removed while in ApplyModifier and waiting deleted
         SpellAuraHolderList m_deletedHolders;
         std::map<uint32, Aura*> m_classScripts;
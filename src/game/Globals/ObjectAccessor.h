@@ -32,20 +32,23 @@
 #include "Entities/Corpse.h"
 
 #include <mutex>
+#include <shared_mutex>
 
 class Unit;
 class WorldObject;
 class Map;
 
+// Find is called from all map threads while Insert/Remove only run on login, logout and corpse changes,
+// so lookups share the lock and only changes take it exclusively
 template <class T>
 class HashMapHolder
 {
     public:
 
         typedef std::unordered_map<ObjectGuid, T*>   MapType;
-        typedef std::mutex LockType;
-        typedef std::lock_guard<std::mutex> ReadGuard;
-        typedef std::lock_guard<std::mutex> WriteGuard;
+        typedef std::shared_mutex LockType;
+        typedef std::shared_lock<std::shared_mutex> ReadGuard;
+        typedef std::unique_lock<std::shared_mutex> WriteGuard;
 
         static void Insert(T* o);
 
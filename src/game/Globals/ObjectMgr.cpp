@@ -1334,6 +1334,12 @@ void ObjectMgr::LoadSpawnGroups()
                     guidData.RandomEntry = true;
             }
         }
+
+        if (!entry.DbGuids.empty())
+        {
+            uint32 mapId = entry.Type == SPAWN_GROUP_CREATURE ? GetCreatureData(entry.DbGuids[0].DbGuid)->mapid : GetGOData(entry.DbGuids[0].DbGuid)->mapid;
+            newContainer->spawnGroupsByMap[mapId].push_back(&entry);
+        }
     }
 
     m_spawnGroupContainer = newContainer;
@@ -1799,6 +1805,9 @@ void ObjectMgr::LoadCreatures()
         else
             data.OriginalZoneId = 0;
 
+        if (sWorld.isForceLoadMap(data.mapid))
+            m_forceLoadCreatures.emplace(data.mapid, guid);
+
         if (data.IsNotPartOfPoolOrEvent()) // if not this is to be managed by GameEvent System or Pool system
         {
             AddCreatureToGrid(guid, &data);
@@ -8934,10 +8943,11 @@ void ObjectMgr::LoadActiveEntities(Map* _map)
     // Load active objects for _map
     if (sWorld.isForceLoadMap(_map->GetId()))
     {
-        for (CreatureDataMap::const_iterator itr = mCreatureDataMap.begin(); itr != mCreatureDataMap.end(); ++itr)
+        auto bounds = m_forceLoadCreatures.equal_range(_map->GetId());
+        for (auto itr = bounds.first; itr != bounds.second; ++itr)
         {
-            if (itr->second.mapid == _map->GetId())
-                _map->ForceLoadGrid(itr->second.posX, itr->second.posY);
+            CreatureData const& data = mCreatureDataMap[itr->second];
+            _map->ForceLoadGrid(data.posX, data.posY);
         }
     }
     else                                                    // Normal case - Load all npcs that are active
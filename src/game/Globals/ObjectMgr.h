@@ -1334,6 +1334,7 @@ class ObjectMgr
         MapObjectGuids mMapObjectGuids;
         ActiveObjectGuidsOnMap m_activeCreatures;
         ActiveObjectGuidsOnMap m_activeGameObjects;
+        ActiveObjectGuidsOnMap m_forceLoadCreatures;      // every creature on maps listed in LoadAllGridsOnMaps
         CreatureSpawnTemplateMap m_creatureSpawnTemplateMap;
         CreatureDataMap mCreatureDataMap;
         CreatureLocaleMap mCreatureLocaleMap;
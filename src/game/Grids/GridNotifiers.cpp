@@ -97,10 +97,13 @@ void VisibleNotifier::Notify()
     if (i_data.HasData())
     {
         // send create/outofrange packet to player (except player create updates that already sent using SendUpdateToPlayer)
-        for (size_t i = 0; i < i_data.GetPacketCount(); ++i)
+        if (player.GetSession()->WantsObjectUpdates())
         {
-            WorldPacket packet = i_data.BuildPacket(i);
-            player.GetSession()->SendPacket(packet);
+            for (size_t i = 0; i < i_data.GetPacketCount(); ++i)
+            {
+                WorldPacket packet = i_data.BuildPacket(i);
+                player.GetSession()->SendPacket(packet);
+            }
         }
 
         // send out of range to other players if need
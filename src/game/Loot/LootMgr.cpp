@@ -32,6 +32,7 @@
 #include "BattleGround/BattleGroundMgr.h"
 #include <sstream>
 #include <iomanip>
+#include <thread>
 #include "Hardcore/HardcoreMgr.h"
 #ifdef BUILD_ELUNA
 #include "LuaEngine/LuaEngine.h"
@@ -64,6 +65,7 @@ class LootTemplate::LootGroup                               // A set of loot def
 {
     public:
         void AddEntry(LootStoreItem& item);                 // Adds an entry to the group (at loading stage)
+        void Compile();                                     // Prepares the rolling tables once all entries are added
         bool HasQuestDrop() const;                          // True if group includes at least 1 quest drop entry
         bool HasQuestDropForPlayer(Player const* player) const;
         // The same for active quests of the player
@@ -77,7 +79,13 @@ class LootTemplate::LootGroup                               // A set of loot def
         LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
         LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
 
+        // Alias table over ExplicitlyChanced plus a last slot for "none of them", only built without conditions
+        std::vector<float> AliasChance;
+        std::vector<uint32> Alias;
+
         LootStoreItem const* Roll(Loot const& loot, Player const* lootOwner) const; // Rolls an item from the group, returns nullptr if all miss their chances
+        LootStoreItem const* RollExplicitlyChanced(Loot const& loot, Player const* lootOwner) const;
+        LootStoreItem const* RollEqualChanced(Loot const& loot, Player const* lootOwner) const;
 };
 
 // Remove all data and free all memory
@@ -178,6 +186,9 @@ void LootStore::LoadLootTable()
 
         Verify();                                           // Checks validity of the loot store
 
+        for (auto& lootTemplate : m_LootTemplates)
+            lootTemplate.second->Compile();
+
         sLog.outString(">> Loaded %u loot definitions (" SIZEFMTD " templates) from table %s", count, m_LootTemplates.size(), GetName());
         sLog.outString();
     }
@@ -2365,78 +2376,146 @@ void LootTemplate::LootGroup::AddEntry(LootStoreItem& item)
         EqualChanced.push_back(item);
 }
 
+// Builds the alias table (Vose's variant of Walker's alias method) for groups rolled without conditions
+void LootTemplate::LootGroup::Compile()
+{
+    AliasChance.clear();
+    Alias.clear();
+
+    // only when chances sum up to at most 100% and none is certain the roll result does not depend on entry order.
+    // With conditions it does: the share of a skipped entry goes to the next one, the shuffled roll spreads it
+    float total = 0.0f;
+    bool orderIndependent = true;
+    for (auto const& item : ExplicitlyChanced)
+    {
+        if (item.chance >= 100.0f || item.conditionId)
+            orderIndependent = false;
+        total += item.chance;
+    }
+
+    if (ExplicitlyChanced.empty() || !orderIndependent || total > 100.0f)
+        return;
+
+    uint32 size = uint32(ExplicitlyChanced.size()) + 1;
+    std::vector<double> scaled(size);
+    for (uint32 i = 0; i < ExplicitlyChanced.size(); ++i)
+        scaled[i] = double(ExplicitlyChanced[i].chance) * size / 100.0;
+    scaled[size - 1] = (100.0 - total) * size / 100.0;
+
+    AliasChance.assign(size, 1.0f);
+    Alias.resize(size);
+    std::vector<uint32> small, large;
+    for (uint32 i = 0; i < size; ++i)
+    {
+        Alias[i] = i;
+        (scaled[i] < 1.0 ? small : large).push_back(i);
+    }
+
+    while (!small.empty() && !large.empty())
+    {
+        uint32 less = small.back();
+        small.pop_back();
+        uint32 more = large.back();
+        large.pop_back();
+
+        AliasChance[less] = float(scaled[less]);
+        Alias[less] = more;
+        scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+        (scaled[more] < 1.0 ? small : large).push_back(more);
+    }
+    // whatever is left over only differs from 1 by rounding and keeps its own slot
+}
+
 // Rolls an item from the group, returns nullptr if all miss their chances
 LootStoreItem const* LootTemplate::LootGroup::Roll(Loot const& loot, Player const* lootOwner) const
 {
     if (!ExplicitlyChanced.empty())                         // First explicitly chanced entries are checked
+        if (LootStoreItem const* lsi = RollExplicitlyChanced(loot, lootOwner))
+            return lsi;
+
+    if (!EqualChanced.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
+        return RollEqualChanced(loot, lootOwner);
+
+    return nullptr;                                            // Empty drop from the group
+}
+
+LootStoreItem const* LootTemplate::LootGroup::RollExplicitlyChanced(Loot const& loot, Player const* lootOwner) const
+{
+    if (!Alias.empty())                                     // one draw, no matter how many entries
     {
-        std::vector <LootStoreItem const*> lootStoreItemVector; // we'll use new vector to make easy the randomization
+        uint32 slot = urand(0, uint32(Alias.size()) - 1);
+        if (rand_norm_f() >= AliasChance[slot])
+            slot = Alias[slot];
 
-        // fill the new vector with correct pointer to our item list
-        for (auto& itr : ExplicitlyChanced)
-            lootStoreItemVector.push_back(&itr);
+        return slot < ExplicitlyChanced.size() ? &ExplicitlyChanced[slot] : nullptr;
+    }
 
-        // randomize the new vector
-        shuffle(lootStoreItemVector.begin(), lootStoreItemVector.end(), *GetRandomGenerator());
+    std::vector <LootStoreItem const*> lootStoreItemVector; // we'll use new vector to make easy the randomization
 
-        float chance = rand_chance_f();
+    // fill the new vector with correct pointer to our item list
+    for (auto& itr : ExplicitlyChanced)
+        lootStoreItemVector.push_back(&itr);
 
-        // as the new vector is randomized we can start from first element and stop at first one that meet the condition
-        for (std::vector <LootStoreItem const*>::const_iterator itr = lootStoreItemVector.begin(); itr != lootStoreItemVector.end(); ++itr)
-        {
-            LootStoreItem const* lsi = *itr;
+    // randomize the new vector
+    shuffle(lootStoreItemVector.begin(), lootStoreItemVector.end(), *GetRandomGenerator());
 
-            if (lsi->conditionId && lootOwner && !LootTemplate::PlayerOrGroupFulfilsCondition(loot, lootOwner, lsi->conditionId))
-            {
-                sLog.outDebug("In explicit chance -> This item cannot be added! (%u)", lsi->itemid);
-                continue;
-            }
+    float chance = rand_chance_f();
 
-            if (lsi->chance >= 100.0f)
-                return lsi;
+    // as the new vector is randomized we can start from first element and stop at first one that meet the condition
+    for (std::vector <LootStoreItem const*>::const_iterator itr = lootStoreItemVector.begin(); itr != lootStoreItemVector.end(); ++itr)
+    {
+        LootStoreItem const* lsi = *itr;
 
-            chance -= lsi->chance;
-            if (chance < 0)
-                return lsi;
+        if (lsi->conditionId && lootOwner && !LootTemplate::PlayerOrGroupFulfilsCondition(loot, lootOwner, lsi->conditionId))
+        {
+            sLog.outDebug("In explicit chance -> This item cannot be added! (%u)", lsi->itemid);
+            continue;
         }
+
+        if (lsi->chance >= 100.0f)
+            return lsi;
+
+        chance -= lsi->chance;
+        if (chance < 0)
+            return lsi;
     }
 
-    if (!EqualChanced.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
-    {
-        std::vector <LootStoreItem const*> lootStoreItemVector; // we'll use new vector to make easy the randomization
+    return nullptr;
+}
 
-        // fill the new vector with correct pointer to our item list
-        for (auto& itr : EqualChanced)
-            lootStoreItemVector.push_back(&itr);
+LootStoreItem const* LootTemplate::LootGroup::RollEqualChanced(Loot const& loot, Player const* lootOwner) const
+{
+    // entries are drawn one by one in random order, most rolls stop at the first draw so the rest is never shuffled
+    static thread_local std::vector<LootStoreItem const*> candidates;
+    candidates.clear();
+    for (auto& itr : EqualChanced)
+        candidates.push_back(&itr);
 
-        // randomize the new vector
-        std::shuffle(lootStoreItemVector.begin(), lootStoreItemVector.end(), *GetRandomGenerator());
+    for (uint32 remaining = uint32(candidates.size()); remaining > 0; --remaining)
+    {
+        uint32 pick = urand(0, remaining - 1);
+        LootStoreItem const* lsi = candidates[pick];
+        candidates[pick] = candidates[remaining - 1];
 
-        // as the new vector is randomized we can start from first element and stop at first one that meet the condition
-        for (std::vector <LootStoreItem const*>::const_iterator itr = lootStoreItemVector.begin(); itr != lootStoreItemVector.end(); ++itr)
+        //check if we already have that item in the loot list
+        if (loot.IsItemAlreadyIn(lsi->itemid))
         {
-            LootStoreItem const* lsi = *itr;
-
-            //check if we already have that item in the loot list
-            if (loot.IsItemAlreadyIn(lsi->itemid))
-            {
-                // the item is already looted, let's give a 50%  chance to pick another one
-                uint32 chance = urand(0, 1);
+            // the item is already looted, let's give a 50%  chance to pick another one
+            uint32 chance = urand(0, 1);
 
-                if (chance)
-                    continue;                               // pass this item
-            }
+            if (chance)
+                continue;                                   // pass this item
+        }
 
-            if (lsi->conditionId && lootOwner && !LootTemplate::PlayerOrGroupFulfilsCondition(loot, lootOwner, lsi->conditionId))
-            {
-                sLog.outDebug("In equal chance -> This item cannot be added! (%u)", lsi->itemid);
-                continue;
-            }
-            return lsi;
+        if (lsi->conditionId && lootOwner && !LootTemplate::PlayerOrGroupFulfilsCondition(loot, lootOwner, lsi->conditionId))
+        {
+            sLog.outDebug("In equal chance -> This item cannot be added! (%u)", lsi->itemid);
+            continue;
         }
+        return lsi;
     }
 
-    return nullptr;                                            // Empty drop from the group
+    return nullptr;
 }
 
 // True if group includes at least 1 quest drop entry
@@ -2550,6 +2629,13 @@ void LootTemplate::AddEntry(LootStoreItem& item)
         Entries.push_back(item);
 }
 
+// Prepares the groups for fast rolling (after loading stage)
+void LootTemplate::Compile()
+{
+    for (auto& group : Groups)
+        group.Compile();
+}
+
 // Rolls for every item in the template and adds the rolled items the the loot
 void LootTemplate::Process(Loot& loot, Player const* lootOwner, LootStore const& store, bool rate, uint8 groupId) const
 {
@@ -3025,8 +3111,6 @@ void LootMgr::CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 loo
     if (amountOfCheck < 1)
         amountOfCheck = 1;
 
-    std::unique_ptr<Loot> loot = std::unique_ptr<Loot>(new Loot(LOOT_DEBUG));
-
     // get loot table for provided loot id
     LootTemplate const* lootTable = store->GetLootFor(lootId);
     if (!lootTable)
@@ -3035,15 +3119,35 @@ void LootMgr::CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 loo
         return;
     }
 
-    // do the loot drop simulation
-    std::unordered_map<uint32, uint32> itemStatsMap;
-    for (uint32 i = 1; i <= amountOfCheck; ++i)
+    // do the loot drop simulation, big runs are split over several threads with their own loot and counters
+    uint32 startTime = WorldTimer::getMSTime();
+    uint32 threadCount = std::max(1u, std::min(std::thread::hardware_concurrency(), amountOfCheck / LOOT_SIMULATION_KILLS_PER_THREAD));
+    std::vector<std::unordered_map<uint32, uint32>> threadStats(threadCount);
+
+    auto simulate = [lootTable, store](uint32 kills, std::unordered_map<uint32, uint32>& stats)
     {
-        lootTable->Process(*loot, nullptr, *store, store->IsRatesAllowed());
-        for (auto lootItem : loot->m_lootItems)
-            ++itemStatsMap[lootItem->itemId];
-        loot->Clear();
-    }
+        Loot loot(LOOT_DEBUG);
+        for (uint32 i = 0; i < kills; ++i)
+        {
+            lootTable->Process(loot, nullptr, *store, store->IsRatesAllowed());
+            for (auto lootItem : loot.m_lootItems)
+                ++stats[lootItem->itemId];
+            loot.Clear();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32 i = 1; i < threadCount; ++i)
+        threads.emplace_back(simulate, amountOfCheck / threadCount, std::ref(threadStats[i]));
+    simulate(amountOfCheck - (amountOfCheck / threadCount) * (threadCount - 1), threadStats[0]);
+    for (std::thread& thread : threads)
+        thread.join();
+
+    std::unordered_map<uint32, uint32> itemStatsMap;
+    for (auto const& stats : threadStats)
+        for (auto const& itemStat : stats)
+            itemStatsMap[itemStat.first] += itemStat.second;
+    uint32 simulationTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
 
     // sort the result
     auto comp = [](std::pair<uint32, uint32> const& a, std::pair<uint32, uint32> const& b) { return a.second > b.second; };
@@ -3051,8 +3155,8 @@ void LootMgr::CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 loo
         itemStatsMap.begin(), itemStatsMap.end(), comp);
 
     // report the result in both chat client and console
-    chat.PSendSysMessage("Results for %u drops simulation of loot id(%u) in %s:", amountOfCheck, lootId, store->GetName());
-    sLog.outString("Results for %u drops simulation of loot id(%u) in %s:", amountOfCheck, lootId, store->GetName());
+    chat.PSendSysMessage("Results for %u drops simulation of loot id(%u) in %s (%u ms, %u threads):", amountOfCheck, lootId, store->GetName(), simulationTime, threadCount);
+    sLog.outString("Results for %u drops simulation of loot id(%u) in %s (%u ms, %u threads):", amountOfCheck, lootId, store->GetName(), simulationTime, threadCount);
     std::stringstream ss;
     for (auto itemStat : sortedResult)
     {
@@ -42,6 +42,8 @@ struct ItemPrototype;
 #define MAX_NR_LOOT_ITEMS 16
 // note: the client cannot show more than 16 items total
 
+#define LOOT_SIMULATION_KILLS_PER_THREAD 50000              // drop simulations smaller than this stay on one thread
+
 enum PermissionTypes
 {
     ALL_PERMISSION    = 0,
@@ -261,6 +263,8 @@ class LootTemplate
     public:
         // Adds an entry to the group (at loading stage)
         void AddEntry(LootStoreItem& item);
+        // Prepares the groups for fast rolling (after loading stage)
+        void Compile();
         // Rolls for every item in the template and adds the rolled items the the loot
         void Process(Loot& loot, Player const* lootOwner, LootStore const& store, bool rate, uint8 groupId = 0) const;
 
@@ -0,0 +1,207 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Maps/AIUpdateScheduler.h"
+#include "Maps/Map.h"
+#include "Entities/Player.h"
+#include "Groups/Group.h"
+#include "World/World.h"
+
+#ifdef BUILD_METRICS
+ #include "Metric/Metric.h"
+#endif
+
+#define AI_UPDATE_TIER_CHECK_INTERVAL 1000                  // how often the tier of a unit is reevaluated (ms)
+
+AIUpdateScheduler::AIUpdateScheduler(Map& map) : m_map(map), m_enabled(false), m_activeDistSq(0.f), m_nearDistSq(0.f),
+    m_tickBudgetUs(0), m_tickTimeUs(0)
+{
+    for (uint32& interval : m_intervals)
+        interval = 0;
+}
+
+void AIUpdateScheduler::Update(uint32 /*diff*/)
+{
+    m_enabled = sWorld.getConfig(CONFIG_BOOL_AI_UPDATE_LOD);
+    if (!m_enabled)
+        return;
+
+    float activeDist = sWorld.getConfig(CONFIG_FLOAT_AI_UPDATE_LOD_ACTIVE_DISTANCE);
+    float nearDist = std::max(activeDist, sWorld.getConfig(CONFIG_FLOAT_AI_UPDATE_LOD_NEAR_DISTANCE));
+    m_activeDistSq = activeDist * activeDist;
+    m_nearDistSq = nearDist * nearDist;
+    m_intervals[AI_UPDATE_TIER_ACTIVE] = 0;
+    m_intervals[AI_UPDATE_TIER_NEAR] = sWorld.getConfig(CONFIG_UINT32_AI_UPDATE_LOD_NEAR_INTERVAL);
+    m_intervals[AI_UPDATE_TIER_FAR] = sWorld.getConfig(CONFIG_UINT32_AI_UPDATE_LOD_FAR_INTERVAL);
+    m_intervals[AI_UPDATE_TIER_IDLE] = sWorld.getConfig(CONFIG_UINT32_AI_UPDATE_LOD_IDLE_INTERVAL);
+    m_tickBudgetUs = uint64(sWorld.getConfig(CONFIG_UINT32_AI_UPDATE_LOD_TICK_BUDGET)) * 1000;
+
+    // close the previous tick
+    m_lastTickStats = m_tickStats;
+    for (uint32 i = 0; i < MAX_AI_UPDATE_TIERS; ++i)
+    {
+        AIUpdateTierStats const& tick = m_tickStats.tiers[i];
+        AIUpdateTierStats& total = m_totalStats.tiers[i];
+        total.units += tick.units;
+        total.updates += tick.updates;
+        total.deferred += tick.deferred;
+        total.timeUs += tick.timeUs;
+    }
+    m_tickStats = AIUpdateStats();
+    m_tickTimeUs = 0;
+
+#ifdef BUILD_METRICS
+    if (m_lastTickStats.tiers[AI_UPDATE_TIER_ACTIVE].units || m_lastTickStats.tiers[AI_UPDATE_TIER_NEAR].units ||
+        m_lastTickStats.tiers[AI_UPDATE_TIER_FAR].units || m_lastTickStats.tiers[AI_UPDATE_TIER_IDLE].units)
+    {
+        static char const* tierNames[MAX_AI_UPDATE_TIERS] = { "active", "near", "far", "idle" };
+        metric::measurement meas("map.update.ai", {
+            { "map_id", std::to_string(m_map.GetId()) },
+            { "instance_id", std::to_string(m_map.GetInstanceId()) }
+        });
+        for (uint32 i = 0; i < MAX_AI_UPDATE_TIERS; ++i)
+        {
+            AIUpdateTierStats const& tick = m_lastTickStats.tiers[i];
+            meas.add_field(std::string(tierNames[i]) + "_units", std::to_string(tick.units));
+            meas.add_field(std::string(tierNames[i]) + "_updates", std::to_string(tick.updates));
+            meas.add_field(std::string(tierNames[i]) + "_deferred", std::to_string(tick.deferred));
+            meas.add_field(std::string(tierNames[i]) + "_time_us", std::to_string(tick.timeUs));
+        }
+    }
+#endif
+
+    // real player positions are all the tier selection needs, collect them once per tick
+    m_realPlayerPositions.clear();
+    for (const auto& itr : m_map.GetPlayers())
+    {
+        Player* player = itr.getSource();
+        if (player && player->IsInWorld() && IsRealPlayer(player))
+            m_realPlayerPositions.emplace_back(player->GetPositionX(), player->GetPositionY());
+    }
+}
+
+bool AIUpdateScheduler::ShouldUpdateAI(Unit* unit, uint32& diff)
+{
+    if (!m_enabled)
+        return true;
+
+    AIUpdateState& state = unit->GetAIUpdateState();
+    state.pendingDiff += diff;
+
+    // entering combat must not wait for the next tier check
+    if (state.tierCheckTimer <= diff || (state.tier != AI_UPDATE_TIER_ACTIVE && unit->IsInCombat()))
+    {
+        state.tier = SelectTier(unit);
+        state.tierCheckTimer = AI_UPDATE_TIER_CHECK_INTERVAL;
+    }
+    else
+        state.tierCheckTimer -= diff;
+
+    AIUpdateTierStats& stats = m_tickStats.tiers[state.tier];
+    ++stats.units;
+
+    if (state.tier != AI_UPDATE_TIER_ACTIVE)
+    {
+        uint32 interval = m_intervals[state.tier];
+        if (state.pendingDiff < interval)
+            return false;
+
+        // over budget, postpone but never starve a unit for more than twice its interval
+        if (m_tickBudgetUs && m_tickTimeUs >= m_tickBudgetUs && state.pendingDiff < interval * 2)
+        {
+            ++stats.deferred;
+            return false;
+        }
+    }
+
+    ++stats.updates;
+    diff = state.pendingDiff;
+    state.pendingDiff = 0;
+    return true;
+}
+
+bool AIUpdateScheduler::IsRealPlayer(Player* player)
+{
+#ifdef BUILD_PLAYERBOT
+    if (player->GetPlayerbotAI())
+        return false;
+#endif
+#ifdef ENABLE_PLAYERBOTS
+    return player->isRealPlayer();
+#else
+    return true;
+#endif
+}
+
+AIUpdateTier AIUpdateScheduler::SelectTier(Unit* unit) const
+{
+    if (unit->IsInCombat() || unit->isActiveObject())
+        return AI_UPDATE_TIER_ACTIVE;
+
+    if (unit->GetTypeId() == TYPEID_PLAYER)
+    {
+        Player* player = static_cast<Player*>(unit);
+        if (IsRealPlayer(player) || player->InBattleGround() || HasRealPlayerInGroup(player))
+            return AI_UPDATE_TIER_ACTIVE;
+    }
+    else if (Player* owner = unit->GetBeneficiaryPlayer())
+    {
+        // pets, guardians and charmed units of real players follow their owner
+        if (IsRealPlayer(owner))
+            return AI_UPDATE_TIER_ACTIVE;
+    }
+
+    if (m_realPlayerPositions.empty())
+        return AI_UPDATE_TIER_IDLE;
+
+    float minDistSq = m_nearDistSq + 1.f;
+    for (auto const& pos : m_realPlayerPositions)
+    {
+        float dx = unit->GetPositionX() - pos.first;
+        float dy = unit->GetPositionY() - pos.second;
+        float distSq = dx * dx + dy * dy;
+        if (distSq <= m_activeDistSq)
+            return AI_UPDATE_TIER_ACTIVE;
+        minDistSq = std::min(minDistSq, distSq);
+    }
+
+    return minDistSq <= m_nearDistSq ? AI_UPDATE_TIER_NEAR : AI_UPDATE_TIER_FAR;
+}
+
+bool AIUpdateScheduler::HasRealPlayerInGroup(Player* player) const
+{
+    Group* group = player->GetGroup();
+    if (!group)
+        return false;
+
+    for (GroupReference* itr = group->GetFirstMember(); itr != nullptr; itr = itr->next())
+    {
+        Player* member = itr->getSource();
+        if (member && member != player && member->IsInWorld() && member->GetMap() == &m_map && IsRealPlayer(member))
+            return true;
+    }
+    return false;
+}
+
+void AIUpdateScheduler::AddUpdateTime(AIUpdateTier tier, uint64 timeUs)
+{
+    m_tickStats.tiers[tier].timeUs += timeUs;
+    // active units are updated every tick anyway, only what can be postponed counts against the budget
+    if (tier != AI_UPDATE_TIER_ACTIVE)
+        m_tickTimeUs += timeUs;
+}
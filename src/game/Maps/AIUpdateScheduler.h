@@ -0,0 +1,138 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_AI_UPDATE_SCHEDULER_H
+#define MANGOS_AI_UPDATE_SCHEDULER_H
+
+#include "Common.h"
+
+#include <chrono>
+#include <vector>
+
+class Map;
+class Unit;
+class Player;
+
+// Level of detail tiers for AI updates, lower tier is updated more often
+enum AIUpdateTier
+{
+    AI_UPDATE_TIER_ACTIVE   = 0,                            // every tick: combat, grouped with or owned by a real player, close to a real player
+    AI_UPDATE_TIER_NEAR     = 1,                            // within AIUpdate.LOD.NearDistance of a real player
+    AI_UPDATE_TIER_FAR      = 2,                            // map has real players, but none near
+    AI_UPDATE_TIER_IDLE     = 3,                            // map has no real players at all
+    MAX_AI_UPDATE_TIERS
+};
+
+// Per unit scheduling state, owned by the unit
+struct AIUpdateState
+{
+    AIUpdateState() : pendingDiff(0), tierCheckTimer(0), tier(AI_UPDATE_TIER_ACTIVE) {}
+
+    uint32 pendingDiff;                                     // time elapsed since the last AI update
+    uint32 tierCheckTimer;                                  // time left until the tier is reevaluated
+    AIUpdateTier tier;
+};
+
+struct AIUpdateTierStats
+{
+    AIUpdateTierStats() : units(0), updates(0), deferred(0), timeUs(0) {}
+
+    uint32 units;                                           // units that asked for an AI update
+    uint32 updates;                                         // AI updates actually run
+    uint32 deferred;                                        // due updates postponed by the tick budget
+    uint64 timeUs;                                          // time spent in AI updates
+};
+
+struct AIUpdateStats
+{
+    AIUpdateTierStats tiers[MAX_AI_UPDATE_TIERS];
+};
+
+/**
+ * Decides how often the AI of the creatures and player bots of one map is run.
+ *
+ * Units keep accumulating their update diff while skipped, so timers inside the AI
+ * still see the full elapsed time once the unit gets its turn.
+ * Only used from the map's own update thread.
+ */
+class AIUpdateScheduler
+{
+    public:
+        AIUpdateScheduler(Map& map);
+
+        // Called once at the start of each map tick
+        void Update(uint32 diff);
+
+        // Returns true when the unit's AI has to run this tick, diff is then replaced with the time accumulated since its last AI update
+        bool ShouldUpdateAI(Unit* unit, uint32& diff);
+
+        bool IsEnabled() const { return m_enabled; }
+
+        // Last completed tick
+        AIUpdateStats const& GetLastTickStats() const { return m_lastTickStats; }
+        // Since map creation
+        AIUpdateStats const& GetTotalStats() const { return m_totalStats; }
+
+        static bool IsRealPlayer(Player* player);
+
+    private:
+        friend class AIUpdateTimeGuard;
+
+        AIUpdateTier SelectTier(Unit* unit) const;
+        bool HasRealPlayerInGroup(Player* player) const;
+        void AddUpdateTime(AIUpdateTier tier, uint64 timeUs);
+
+        Map& m_map;
+
+        bool m_enabled;
+        float m_activeDistSq;
+        float m_nearDistSq;
+        uint32 m_intervals[MAX_AI_UPDATE_TIERS];
+        uint64 m_tickBudgetUs;
+
+        uint64 m_tickTimeUs;                                // time spent in non active AI updates this tick
+        std::vector<std::pair<float, float>> m_realPlayerPositions;
+
+        AIUpdateStats m_tickStats;
+        AIUpdateStats m_lastTickStats;
+        AIUpdateStats m_totalStats;
+};
+
+// Accounts the time spent in one AI update to the tier the unit was scheduled in
+class AIUpdateTimeGuard
+{
+    public:
+        AIUpdateTimeGuard(AIUpdateScheduler& scheduler, AIUpdateTier tier) : m_scheduler(scheduler), m_tier(tier), m_enabled(scheduler.IsEnabled())
+        {
+            if (m_enabled)
+                m_start = std::chrono::steady_clock::now();
+        }
+        ~AIUpdateTimeGuard()
+        {
+            if (m_enabled)
+                m_scheduler.AddUpdateTime(m_tier, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count());
+        }
+
+    private:
+        AIUpdateScheduler& m_scheduler;
+        AIUpdateTier m_tier;
+        bool m_enabled;
+        std::chrono::steady_clock::time_point m_start;
+};
+
+#endif
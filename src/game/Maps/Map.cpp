@@ -185,8 +185,9 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId)
       m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(nullptr),
       m_activeNonPlayersIter(m_activeNonPlayers.end()), m_onEventNotifiedIter(m_onEventNotifiedObjects.end()),
       i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
-      i_data(nullptr), i_script_id(0), m_transportsIterator(m_transports.begin()), m_spawnManager(*this),
-      m_variableManager(this), m_activeAreasTimer(0), hasRealPlayers(false)
+      i_data(nullptr), i_script_id(0), m_transportsIterator(m_transports.begin()), m_spawnManager(*this), m_aiUpdateScheduler(*this),
+      m_variableManager(this), m_activeAreasTimer(0), hasRealPlayers(false),
+      m_tickArena(MAP_TICK_ARENA_INITIAL_SIZE)
 {
     m_weatherSystem = new WeatherSystem(this);
 #ifdef BUILD_ELUNA
@@ -420,6 +421,43 @@ uint32 Map::GetLoadedGridsCount()
     return count;
 }
 
+MapMemoryStats Map::GetMemoryStats() const
+{
+    MapMemoryStats stats;
+    stats.grids = 0;
+    stats.objects = 0;
+    stats.objectBytes = 0;
+    for (uint32 i = 0; i < MAX_NUMBER_OF_GRIDS; ++i)
+    {
+        for (uint32 k = 0; k < MAX_NUMBER_OF_GRIDS; ++k)
+        {
+            NGridType const* grid = i_grids[i][k];
+            if (!grid)
+                continue;
+
+            ++stats.grids;
+
+            uint32 creatures = grid->GridObjectCount<Creature>();
+            uint32 pets = grid->WorldObjectCount<Creature>();
+            uint32 gameObjects = grid->GridObjectCount<GameObject>();
+            uint32 dynamicObjects = grid->GridObjectCount<DynamicObject>();
+            uint32 corpses = grid->GridObjectCount<Corpse>() + grid->WorldObjectCount<Corpse>();
+
+            stats.objects += creatures + pets + gameObjects + dynamicObjects + corpses;
+            stats.objectBytes += uint64(creatures) * sizeof(Creature) + uint64(pets) * sizeof(Pet) + uint64(gameObjects) * sizeof(GameObject) +
+                uint64(dynamicObjects) * sizeof(DynamicObject) + uint64(corpses) * sizeof(Corpse);
+        }
+    }
+
+    stats.gridBytes = uint64(stats.grids) * sizeof(NGridType);
+    stats.dynamicModels = uint32(m_dyn_tree.size());
+    stats.spawnGroups = m_spawnManager.GetSpawnGroupCount();
+    stats.players = m_mapRefManager.getSize();
+    stats.tickArenaBytes = m_tickArena.GetBufferSize();
+    stats.tickArenaUpstreamAllocations = m_tickArena.GetUpstreamAllocations();
+    return stats;
+}
+
 void Map::ForceLoadGrid(float x, float y)
 {
     if (!IsLoaded(x, y))
@@ -959,11 +997,15 @@ void Map::Update(const uint32& t_diff)
 
     GetMessager().Execute(this);
     m_spawnManager.Update();
+    m_aiUpdateScheduler.Update(t_diff);
 
     /// update active cells around players and active objects
     resetMarkedCells();
 
-    WorldObjectUnSet objToUpdate;
+    // nothing of the previous tick is alive anymore
+    m_tickArena.Reset();
+
+    WorldObjectUnSet objToUpdate(m_tickArena.GetResource());
     MaNGOS::ObjectUpdater obj_updater(objToUpdate, t_diff);
     TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(obj_updater);    // For creature
     TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(obj_updater);   // For pets
@@ -1094,7 +1136,17 @@ void Map::Update(const uint32& t_diff)
 
             plr->Update(t_diff);
 #ifdef ENABLE_PLAYERBOTS
-            plr->UpdateAI(t_diff, !(isInActiveArea || updateAI || plr->IsInCombat()));
+            if (m_aiUpdateScheduler.IsEnabled())
+            {
+                uint32 aiDiff = t_diff;
+                if (m_aiUpdateScheduler.ShouldUpdateAI(plr, aiDiff))
+                {
+                    AIUpdateTimeGuard aiTime(m_aiUpdateScheduler, plr->GetAIUpdateState().tier);
+                    plr->UpdateAI(aiDiff, false);
+                }
+            }
+            else
+                plr->UpdateAI(t_diff, !(isInActiveArea || updateAI || plr->IsInCombat()));
 #endif
         }
     }
@@ -1237,7 +1289,7 @@ void Map::Update(const uint32& t_diff)
     }
 
     ///- Process necessary scripts
-    if (!m_scriptSchedule.empty())
+    if (!m_scriptSchedule.IsEmpty())
         ScriptsProcess();
 
 #ifdef BUILD_ELUNA
@@ -2419,15 +2471,12 @@ bool Map::ScriptsStart(ScriptMapType scriptType, uint32 id, Object* source, Obje
 
     if (execParams)                                         // Check if the execution should be uniquely
     {
-        for (ScriptScheduleMap::const_iterator searchItr = m_scriptSchedule.begin(); searchItr != m_scriptSchedule.end(); ++searchItr)
+        if (m_scriptSchedule.HasScript(scriptMapMap->first, id,
+                                       execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_SOURCE ? sourceGuid : ObjectGuid(),
+                                       execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_TARGET ? targetGuid : ObjectGuid(), ownerGuid))
         {
-            if (searchItr->second.IsSameScript(scriptMapMap->first, id,
-                                               execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_SOURCE ? sourceGuid : ObjectGuid(),
-                                               execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_TARGET ? targetGuid : ObjectGuid(), ownerGuid))
-            {
-                DETAIL_FILTER_LOG(LOG_FILTER_DB_SCRIPT, "DB-SCRIPTS: Process table `%s` id %u. Skip script as script already started for source %s, target %s - ScriptsStartParams %u", scriptMapMap->first, id, sourceGuid.GetString().c_str(), targetGuid.GetString().c_str(), execParams);
-                return true;
-            }
+            DETAIL_FILTER_LOG(LOG_FILTER_DB_SCRIPT, "DB-SCRIPTS: Process table `%s` id %u. Skip script as script already started for source %s, target %s - ScriptsStartParams %u", scriptMapMap->first, id, sourceGuid.GetString().c_str(), targetGuid.GetString().c_str(), execParams);
+            return true;
         }
     }
 
@@ -2455,7 +2504,7 @@ bool Map::ScriptsStart(ScriptMapType scriptType, uint32 id, Object* source, Obje
     {
         auto const& scriptInfo = scriptInfoItr->second;
         ScriptAction sa(scriptType, this, sourceGuid, targetGuid, ownerGuid, scriptInfo);
-        m_scriptSchedule.emplace(GetCurrentClockTime() + std::chrono::milliseconds(scriptInfoItr->first), sa);
+        m_scriptSchedule.Schedule(GetCurrentClockTime() + std::chrono::milliseconds(scriptInfoItr->first), sa);
     }
 
     return true;
@@ -2474,7 +2523,7 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
 
     if (delay)
     {
-        m_scriptSchedule.emplace(GetCurrentClockTime() + std::chrono::milliseconds(delay), sa);
+        m_scriptSchedule.Schedule(GetCurrentClockTime() + std::chrono::milliseconds(delay), sa);
     }
     else
         sa.HandleScriptStep();
@@ -2483,36 +2532,7 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
 /// Process queued scripts
 void Map::ScriptsProcess()
 {
-    if (m_scriptSchedule.empty())
-        return;
-
-    ///- Process overdue queued scripts
-    ScriptScheduleMap::iterator iter = m_scriptSchedule.begin();
-    // ok as multimap is a *sorted* associative container
-    while (!m_scriptSchedule.empty() && (iter->first <= GetCurrentClockTime()))
-    {
-        if (iter->second.HandleScriptStep())
-        {
-            // Terminate following script steps of this script
-            const char* tableName = iter->second.GetTableName();
-            uint32 id = iter->second.GetId();
-            ObjectGuid sourceGuid = iter->second.GetSourceGuid();
-            ObjectGuid targetGuid = iter->second.GetTargetGuid();
-            ObjectGuid ownerGuid = iter->second.GetOwnerGuid();
-
-            for (ScriptScheduleMap::iterator rmItr = m_scriptSchedule.begin(); rmItr != m_scriptSchedule.end();)
-            {
-                if (rmItr->second.IsSameScript(tableName, id, sourceGuid, targetGuid, ownerGuid))
-                    m_scriptSchedule.erase(rmItr++);
-                else
-                    ++rmItr;
-            }
-        }
-        else
-            m_scriptSchedule.erase(iter);
-
-        iter = m_scriptSchedule.begin();
-    }
+    m_scriptSchedule.Process(GetCurrentClockTime());
 }
 
 /**
@@ -2643,7 +2663,7 @@ WorldObject* Map::GetWorldObject(ObjectGuid guid)
 
 void Map::SendObjectUpdates()
 {
-    UpdateDataMapType update_players;
+    UpdateDataMapType update_players(m_tickArena.GetResource());
 
     while (!i_objectsToClientUpdate.empty())
     {
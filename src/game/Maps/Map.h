@@ -32,13 +32,16 @@
 #include "GameSystem/GridRefManager.h"
 #include "MapRefManager.h"
 #include "DBScripts/ScriptMgr.h"
+#include "DBScripts/ScriptActionQueue.h"
 #include "Entities/CreatureLinkingMgr.h"
 #include "vmap/DynamicTree.h"
 #include "Multithreading/Messager.h"
 #include "Globals/GraveyardManager.h"
 #include "Maps/SpawnManager.h"
+#include "Maps/AIUpdateScheduler.h"
 #include "Maps/MapDataContainer.h"
 #include "World/WorldStateVariableManager.h"
+#include "Maps/MapTickArena.h"
 
 #include <bitset>
 #include <functional>
@@ -132,6 +135,20 @@ struct WorldTemplate
 #endif
 
 #define MIN_UNLOAD_DELAY      1                             // immediate unload
+#define MAP_TICK_ARENA_INITIAL_SIZE (16 * 1024)             // first chunk of the per tick arena of a map
+
+struct MapMemoryStats
+{
+    uint32 grids;                                           // allocated grids, cells included
+    uint64 gridBytes;                                       // fixed size of the grids and their cells, without the objects
+    uint32 objects;                                         // creatures, pets, gameobjects, dynamic objects and corpses in the grids
+    uint64 objectBytes;                                     // fixed size of those objects, what they allocate on their own is not counted
+    uint32 dynamicModels;                                   // gameobject models in the line of sight tree
+    uint32 spawnGroups;                                     // own state only, the group entries are shared
+    uint32 players;
+    uint64 tickArenaBytes;                                  // buffer of the per tick arena
+    uint64 tickArenaUpstreamAllocations;                    // heap allocations the arena could not avoid since map creation
+};
 
 class Map : public GridRefManager<NGridType>
 {
@@ -401,6 +418,10 @@ class Map : public GridRefManager<NGridType>
         bool CanSpawn(TypeID typeId, uint32 dbGuid);
 
         SpawnManager& GetSpawnManager() { return m_spawnManager; }
+        AIUpdateScheduler& GetAIUpdateScheduler() { return m_aiUpdateScheduler; }
+        ScriptActionQueueStats GetScriptScheduleStats() const { return m_scriptSchedule.GetStats(); }
+        // what this map allocates for itself, terrain, spawn data and scripts are shared by all maps with the same id
+        MapMemoryStats GetMemoryStats() const;
 
         MapDataContainer& GetMapDataContainer() { return m_dataContainer; }
         MapDataContainer const& GetMapDataContainer() const { return m_dataContainer; }
@@ -516,8 +537,7 @@ class Map : public GridRefManager<NGridType>
         mutable std::mutex i_objectsToRemove_lock;
         WorldObjectSet i_objectsToRemove;
 
-        typedef std::multimap<TimePoint, ScriptAction> ScriptScheduleMap;
-        ScriptScheduleMap m_scriptSchedule;
+        ScriptActionQueue m_scriptSchedule;
 
         InstanceData* i_data;
         uint32 i_script_id;
@@ -553,6 +573,9 @@ class Map : public GridRefManager<NGridType>
         // spawning
         SpawnManager m_spawnManager;
 
+        // level of detail of creature and bot AI updates
+        AIUpdateScheduler m_aiUpdateScheduler;
+
         struct StringIdMapStorage
         {
             std::vector<WorldObject*> worldObjects;
@@ -574,6 +597,10 @@ class Map : public GridRefManager<NGridType>
         bool hasRealPlayers;
 
         uint32 _lastMapUpdate;
+
+        // Containers living for one Map::Update take their memory from the arena, it is reset at the start
+        // of the next update
+        MapTickArena m_tickArena;
 };
 
 class WorldMap : public Map
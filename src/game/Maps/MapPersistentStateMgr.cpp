@@ -46,7 +46,7 @@ static uint32 resetEventTypeDelay[MAX_RESET_EVENT_TYPE] = { 0,
 //== MapPersistentState functions ==========================
 MapPersistentState::MapPersistentState(uint16 MapId, uint32 InstanceId)
     : m_instanceid(InstanceId), m_mapid(MapId),
-      m_usedByMap(nullptr)
+      m_usedByMap(nullptr), m_hibernated(false)
 {
 }
 
@@ -59,6 +59,65 @@ MapEntry const* MapPersistentState::GetMapEntry() const
     return sMapStore.LookupEntry(m_mapid);
 }
 
+void MapPersistentState::SetUsedByMapState(Map* map)
+{
+    m_usedByMap = map;
+    if (map)
+        WakeUp();
+    else
+    {
+        Hibernate();
+        UnloadIfEmpty();                                    // expired respawn times no longer hold the state
+    }
+}
+
+void MapPersistentState::Hibernate()
+{
+    if (m_hibernated)
+        return;
+
+    PackRespawnTimes(m_creatureRespawnTimes, m_packedCreatureRespawnTimes);
+    PackRespawnTimes(m_goRespawnTimes, m_packedGORespawnTimes);
+    m_hibernated = true;
+}
+
+void MapPersistentState::WakeUp()
+{
+    if (!m_hibernated)
+        return;
+
+    UnpackRespawnTimes(m_packedCreatureRespawnTimes, m_creatureRespawnTimes);
+    UnpackRespawnTimes(m_packedGORespawnTimes, m_goRespawnTimes);
+    m_hibernated = false;
+}
+
+void MapPersistentState::PackRespawnTimes(RespawnTimes& from, PackedRespawnTimes& to)
+{
+    time_t now = sWorld.GetGameTime();
+
+    to.clear();
+    for (auto const& respawnTime : from)
+        if (respawnTime.second > now)
+            to.push_back(respawnTime);
+    std::sort(to.begin(), to.end());
+    to.shrink_to_fit();
+
+    RespawnTimes().swap(from);                              // clear() keeps the buckets
+}
+
+void MapPersistentState::UnpackRespawnTimes(PackedRespawnTimes& from, RespawnTimes& to)
+{
+    to.reserve(from.size());
+    to.insert(from.begin(), from.end());
+    PackedRespawnTimes().swap(from);
+}
+
+time_t MapPersistentState::GetPackedRespawnTime(PackedRespawnTimes const& times, uint32 loguid)
+{
+    auto itr = std::lower_bound(times.begin(), times.end(), loguid, [](std::pair<uint32, time_t> const& entry, uint32 guid) { return entry.first < guid; });
+    return itr != times.end() && itr->first == loguid ? itr->second : 0;
+}
+
 /* true if the instance state is still valid */
 bool MapPersistentState::UnloadIfEmpty()
 {
@@ -135,6 +194,7 @@ void MapPersistentState::SaveObjectRespawnTime(uint32 typeId, uint32 loguid, tim
 
 void MapPersistentState::SetCreatureRespawnTime(uint32 loguid, time_t t)
 {
+    WakeUp();                                               // rare without a map, pool updates and startup loading
     if (t > sWorld.GetGameTime())
         m_creatureRespawnTimes[loguid] = t;
     else
@@ -146,6 +206,7 @@ void MapPersistentState::SetCreatureRespawnTime(uint32 loguid, time_t t)
 
 void MapPersistentState::SetGORespawnTime(uint32 loguid, time_t t)
 {
+    WakeUp();
     if (t > sWorld.GetGameTime())
         m_goRespawnTimes[loguid] = t;
     else
@@ -157,6 +218,8 @@ void MapPersistentState::SetGORespawnTime(uint32 loguid, time_t t)
 
 void MapPersistentState::ClearRespawnTimes()
 {
+    m_packedGORespawnTimes.clear();
+    m_packedCreatureRespawnTimes.clear();
     m_goRespawnTimes.clear();
     m_creatureRespawnTimes.clear();
 
@@ -962,11 +1025,12 @@ void MapPersistentStateManager::_ResetOrWarnAll(uint32 mapid, bool warn, uint32
     sMapMgr.DoForAllMapsWithMapId(mapid, worker);
 }
 
-void MapPersistentStateManager::GetStatistics(uint32& numStates, uint32& numBoundPlayers, uint32& numBoundGroups)
+void MapPersistentStateManager::GetStatistics(uint32& numStates, uint32& numBoundPlayers, uint32& numBoundGroups, uint32& numHibernated)
 {
     numStates = 0;
     numBoundPlayers = 0;
     numBoundGroups = 0;
+    numHibernated = 0;
 
     // only instanceable maps have bounds
     for (auto& itr : m_instanceSaveByInstanceId)
@@ -977,9 +1041,18 @@ void MapPersistentStateManager::GetStatistics(uint32& numStates, uint32& numBoun
         ++numStates;
         numBoundPlayers += ((DungeonPersistentState*)itr.second)->GetPlayerCount();
         numBoundGroups += ((DungeonPersistentState*)itr.second)->GetGroupCount();
+        if (itr.second->IsHibernated())
+            ++numHibernated;
     }
 }
 
+void MapPersistentStateManager::HibernateUnusedStates()
+{
+    for (auto& itr : m_instanceSaveByInstanceId)
+        if (!itr.second->IsUsedByMap())
+            itr.second->Hibernate();
+}
+
 void MapPersistentStateManager::_CleanupExpiredInstancesAtTime(time_t t)
 {
     _DelHelper(CharacterDatabase, "id, map", "instance", "LEFT JOIN instance_reset ON mapid = map WHERE (instance.resettime < '" UI64FMTD "' AND instance.resettime > '0') OR (NOT instance_reset.resettime IS NULL AND instance_reset.resettime < '" UI64FMTD "')", (uint64)t, (uint64)t);
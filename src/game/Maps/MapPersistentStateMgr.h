@@ -28,6 +28,7 @@
 #include <list>
 #include <map>
 #include <mutex>
+#include <vector>
 
 struct InstanceTemplate;
 struct MapEntry;
@@ -73,22 +74,24 @@ class MapPersistentState
         MapEntry const* GetMapEntry() const;
 
         bool IsUsedByMap() const { return m_usedByMap != nullptr; }
+        bool IsHibernated() const { return m_hibernated; }
         Map* GetMap() const { return m_usedByMap; }         // Can be nullptr if map not loaded for persistent state
-        void SetUsedByMapState(Map* map)
-        {
-            m_usedByMap = map;
-            if (!map)
-                UnloadIfEmpty();
-        }
+        void SetUsedByMapState(Map* map);
 
         time_t GetCreatureRespawnTime(uint32 loguid) const
         {
+            if (m_hibernated)
+                return GetPackedRespawnTime(m_packedCreatureRespawnTimes, loguid);
+
             RespawnTimes::const_iterator itr = m_creatureRespawnTimes.find(loguid);
             return itr != m_creatureRespawnTimes.end() ? itr->second : 0;
         }
         void SaveCreatureRespawnTime(uint32 loguid, time_t t);
         time_t GetGORespawnTime(uint32 loguid) const
         {
+            if (m_hibernated)
+                return GetPackedRespawnTime(m_packedGORespawnTimes, loguid);
+
             RespawnTimes::const_iterator itr = m_goRespawnTimes.find(loguid);
             return itr != m_goRespawnTimes.end() ? itr->second : 0;
         }
@@ -116,14 +119,27 @@ class MapPersistentState
 
         bool UnloadIfEmpty();
         void ClearRespawnTimes();
-        bool HasRespawnTimes() const { return !m_creatureRespawnTimes.empty() || !m_goRespawnTimes.empty(); }
+        bool HasRespawnTimes() const
+        {
+            return !m_creatureRespawnTimes.empty() || !m_goRespawnTimes.empty() ||
+                !m_packedCreatureRespawnTimes.empty() || !m_packedGORespawnTimes.empty();
+        }
 
     private:
         void SetCreatureRespawnTime(uint32 loguid, time_t t);
         void SetGORespawnTime(uint32 loguid, time_t t);
 
+        // while no map uses the state, respawn times only get read, so they are kept as sorted arrays without expired entries
+        void Hibernate();
+        void WakeUp();
+
     private:
         typedef std::unordered_map<uint32, time_t> RespawnTimes;
+        typedef std::vector<std::pair<uint32, time_t> > PackedRespawnTimes;     // sorted by guid
+
+        static void PackRespawnTimes(RespawnTimes& from, PackedRespawnTimes& to);
+        static void UnpackRespawnTimes(PackedRespawnTimes& from, RespawnTimes& to);
+        static time_t GetPackedRespawnTime(PackedRespawnTimes const& times, uint32 loguid);
 
         uint32 m_instanceid;
         uint32 m_mapid;
@@ -132,6 +148,9 @@ class MapPersistentState
         // persistent data
         RespawnTimes m_creatureRespawnTimes;                // lock MapPersistentState from unload, for example for temporary bound dungeon unload delay
         RespawnTimes m_goRespawnTimes;                      // lock MapPersistentState from unload, for example for temporary bound dungeon unload delay
+        PackedRespawnTimes m_packedCreatureRespawnTimes;    // used instead of the maps above while hibernated
+        PackedRespawnTimes m_packedGORespawnTimes;
+        bool m_hibernated;
         MapCellObjectGuidsMap m_gridObjectGuids;            // Single map copy specific grid spawn data, like pool spawns
 
         SpawnedPoolData m_spawnedPoolData;                  // Pools spawns state for map copy
@@ -347,7 +366,9 @@ class MapPersistentStateManager : public MaNGOS::Singleton<MapPersistentStateMan
 
         static void DeleteInstanceFromDB(uint32 instanceid);
 
-        void GetStatistics(uint32& numStates, uint32& numBoundPlayers, uint32& numBoundGroups);
+        void GetStatistics(uint32& numStates, uint32& numBoundPlayers, uint32& numBoundGroups, uint32& numHibernated);
+        // packs the respawn times of states loaded at startup, a map using the state unpacks them again
+        void HibernateUnusedStates();
 
         void Update() { m_Scheduler.Update(); }
     private:
@@ -0,0 +1,56 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Maps/MapTickArena.h"
+
+void* MapTickArena::UpstreamResource::do_allocate(size_t bytes, size_t alignment)
+{
+    ++allocations;
+    tickBytes += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void MapTickArena::UpstreamResource::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+MapTickArena::MapTickArena(size_t initialSize) :
+    m_buffer(new std::byte[initialSize]), m_bufferSize(initialSize), m_growCount(0)
+{
+    m_arena.emplace(m_buffer.get(), m_bufferSize, &m_upstream);
+}
+
+void MapTickArena::Reset()
+{
+    if (!m_upstream.tickBytes)
+    {
+        // back to the start of the buffer
+        m_arena->release();
+        return;
+    }
+
+    // last tick overflowed, give the chunks back and grow the buffer to what was used
+    size_t newSize = m_bufferSize + m_upstream.tickBytes;
+    m_upstream.tickBytes = 0;
+    m_arena.reset();
+    m_buffer.reset(new std::byte[newSize]);
+    m_bufferSize = newSize;
+    ++m_growCount;
+    m_arena.emplace(m_buffer.get(), m_bufferSize, &m_upstream);
+}
@@ -0,0 +1,67 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MAP_TICK_ARENA_H
+#define MANGOS_MAP_TICK_ARENA_H
+
+#include "Common.h"
+
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+// Memory for containers that live for a single Map::Update. The arena hands out memory from a buffer owned
+// by the map, Reset() at the start of the next update makes all of it available again. When a tick does
+// not fit, the overflow is taken from the heap and the buffer is grown to that high water mark at the
+// following Reset(), so a map in steady state does not allocate at all.
+class MapTickArena
+{
+    public:
+        explicit MapTickArena(size_t initialSize);
+
+        MapTickArena(MapTickArena const&) = delete;
+        MapTickArena& operator=(MapTickArena const&) = delete;
+
+        void Reset();
+
+        std::pmr::memory_resource* GetResource() { return &*m_arena; }
+
+        size_t GetBufferSize() const { return m_bufferSize; }
+        uint64 GetUpstreamAllocations() const { return m_upstream.allocations; }
+        uint32 GetGrowCount() const { return m_growCount; }
+
+    private:
+        // counts what the arena could not serve from the buffer
+        struct UpstreamResource : public std::pmr::memory_resource
+        {
+            uint64 allocations = 0;
+            size_t tickBytes = 0;
+
+            void* do_allocate(size_t bytes, size_t alignment) override;
+            void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+            bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override { return this == &other; }
+        };
+
+        UpstreamResource m_upstream;
+        std::unique_ptr<std::byte[]> m_buffer;
+        size_t m_bufferSize;
+        uint32 m_growCount;
+        std::optional<std::pmr::monotonic_buffer_resource> m_arena;
+};
+
+#endif
@@ -157,6 +157,7 @@ struct SpawnGroupEntryContainer
 {
     std::map<uint32, SpawnGroupEntry> spawnGroupMap;
     std::map<std::pair<uint32, uint32>, SpawnGroupEntry*> spawnGroupByGuidMap;
+    std::map<uint32, std::vector<SpawnGroupEntry const*>> spawnGroupsByMap; // shared by all instances of the map, lowest id first
 };
 
 #endif
\ No newline at end of file
@@ -22,11 +22,6 @@
 #include "Maps/SpawnGroupDefines.h"
 #include "Maps/MapPersistentStateMgr.h"
 
-bool operator<(SpawnInfo const& lhs, SpawnInfo const& rhs)
-{
-    return lhs.GetRespawnTime() < rhs.GetRespawnTime();
-}
-
 bool SpawnInfo::ConstructForMap(Map& map)
 {
     m_inUse = true;
@@ -50,114 +45,118 @@ SpawnManager::~SpawnManager()
 void SpawnManager::Initialize()
 {
     auto spawnGroupData = m_map.GetMapDataContainer().GetSpawnGroups();
-    for (auto& groupData : spawnGroupData->spawnGroupMap)
-    {
-        SpawnGroupEntry const& entry = groupData.second;
-        if (entry.DbGuids.empty())
-            continue;
-        if (entry.Type == SPAWN_GROUP_CREATURE)
-        {
-            if (m_map.GetId() != sObjectMgr.GetCreatureData(entry.DbGuids[0].DbGuid)->mapid)
-                continue;
-        }
-        else
-        {
-            if (m_map.GetId() != sObjectMgr.GetGOData(entry.DbGuids[0].DbGuid)->mapid)
-                continue;
-        }
+    auto mapGroups = spawnGroupData->spawnGroupsByMap.find(m_map.GetId());
+    if (mapGroups == spawnGroupData->spawnGroupsByMap.end())
+        return;
 
+    for (SpawnGroupEntry const* entry : mapGroups->second)
+    {
         SpawnGroup* spawnGroup = nullptr;
-        if (entry.Type == SPAWN_GROUP_CREATURE)
-            spawnGroup = new CreatureGroup(entry, m_map);
+        if (entry->Type == SPAWN_GROUP_CREATURE)
+            spawnGroup = new CreatureGroup(*entry, m_map);
         else
-            spawnGroup = new GameObjectGroup(entry, m_map);
-        m_spawnGroups.emplace(entry.Id, spawnGroup);
+            spawnGroup = new GameObjectGroup(*entry, m_map);
+        m_spawnGroups.emplace(entry->Id, spawnGroup);
     }
 }
 
 void SpawnManager::AddCreature(uint32 respawnDelay, uint32 dbguid)
 {
-    m_spawns.emplace_back(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay), dbguid, HIGHGUID_UNIT);
-    std::sort(m_spawns.begin(), m_spawns.end());
+    TimePoint when = m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay);
+    m_spawns.emplace(when, SpawnInfo(when, dbguid, HIGHGUID_UNIT));
 }
 
 void SpawnManager::AddGameObject(uint32 respawnDelay, uint32 dbguid)
 {
-    m_spawns.emplace_back(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay), dbguid, HIGHGUID_GAMEOBJECT);
-    std::sort(m_spawns.begin(), m_spawns.end());
+    TimePoint when = m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay);
+    m_spawns.emplace(when, SpawnInfo(when, dbguid, HIGHGUID_GAMEOBJECT));
 }
 
-void SpawnManager::RespawnCreature(uint32 dbguid, uint32 respawnDelay)
+SpawnManager::SpawnQueue::iterator SpawnManager::FindSpawn(uint32 dbguid, HighGuid high)
 {
-    bool found = false;
-    auto itr = m_spawns.begin();
-    for (; itr != m_spawns.end(); )
+    for (auto itr = m_spawns.begin(); itr != m_spawns.end(); ++itr)
     {
-        auto& spawnInfo = *itr;
-        if (!spawnInfo.IsUsed() && spawnInfo.GetDbGuid() == dbguid && spawnInfo.GetHighGuid() == HIGHGUID_UNIT)
-        {
-            found = true;
-            m_map.GetPersistentState()->SaveCreatureRespawnTime(dbguid, time(nullptr) + respawnDelay);
-            if (respawnDelay > 0)
-                spawnInfo.SetRespawnTime(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay));
-            break;
-        }
-        ++itr;
+        SpawnInfo const& spawnInfo = itr->second;
+        if (!spawnInfo.IsUsed() && spawnInfo.GetDbGuid() == dbguid && spawnInfo.GetHighGuid() == high)
+            return itr;
     }
-    if (!found)
-        AddCreature(respawnDelay, dbguid);
-    else if (respawnDelay == 0)
-        (*itr).ConstructForMap(m_map);
-    if (respawnDelay > 0)
-        std::sort(m_spawns.begin(), m_spawns.end());
+    return m_spawns.end();
 }
 
-void SpawnManager::RespawnGameObject(uint32 dbguid, uint32 respawnDelay)
+void SpawnManager::Schedule(SpawnQueue::iterator itr, TimePoint const& when)
 {
-    bool found = false;
-    auto itr = m_spawns.begin();
-    for (; itr != m_spawns.end(); )
+    // rekey without copying the entry, iterators to other entries stay valid
+    auto node = m_spawns.extract(itr);
+    node.key() = when;
+    node.mapped().SetRespawnTime(when);
+    m_spawns.insert(std::move(node));
+}
+
+void SpawnManager::Respawn(uint32 dbguid, HighGuid high, uint32 respawnDelay)
+{
+    auto itr = FindSpawn(dbguid, high);
+    if (itr == m_spawns.end())
     {
-        auto& spawnInfo = *itr;
-        if (!spawnInfo.IsUsed() && spawnInfo.GetDbGuid() == dbguid && spawnInfo.GetHighGuid() == HIGHGUID_GAMEOBJECT)
-        {
-            found = true;
-            m_map.GetPersistentState()->SaveGORespawnTime(dbguid, time(nullptr) + respawnDelay);
-            if (respawnDelay > 0)
-                spawnInfo.SetRespawnTime(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay));
-            break;
-        }
-        ++itr;
+        if (high == HIGHGUID_UNIT)
+            AddCreature(respawnDelay, dbguid);
+        else
+            AddGameObject(respawnDelay, dbguid);
+        return;
     }
-    if (!found)
-        AddGameObject(respawnDelay, dbguid);
-    else if (respawnDelay == 0)
-        (*itr).ConstructForMap(m_map);
+
+    if (high == HIGHGUID_UNIT)
+        m_map.GetPersistentState()->SaveCreatureRespawnTime(dbguid, time(nullptr) + respawnDelay);
+    else
+        m_map.GetPersistentState()->SaveGORespawnTime(dbguid, time(nullptr) + respawnDelay);
+
     if (respawnDelay > 0)
-        std::sort(m_spawns.begin(), m_spawns.end());
+        Schedule(itr, m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay));
+    else
+        itr->second.ConstructForMap(m_map);                 // a used entry is dropped once Update reaches it
+}
+
+void SpawnManager::RespawnCreature(uint32 dbguid, uint32 respawnDelay)
+{
+    Respawn(dbguid, HIGHGUID_UNIT, respawnDelay);
+}
+
+void SpawnManager::RespawnGameObject(uint32 dbguid, uint32 respawnDelay)
+{
+    Respawn(dbguid, HIGHGUID_GAMEOBJECT, respawnDelay);
 }
 
 void SpawnManager::RespawnAll()
 {
-    for (auto itr = m_spawns.begin(); itr != m_spawns.end();)
+    for (auto itr = m_spawns.begin(); itr != m_spawns.end(); ++itr)
     {
-        auto& spawnInfo = *itr;
+        auto& spawnInfo = itr->second;
+        if (spawnInfo.IsUsed())
+            continue;
         if (spawnInfo.GetHighGuid() == HIGHGUID_GAMEOBJECT)
             m_map.GetPersistentState()->SaveGORespawnTime(spawnInfo.GetDbGuid(), 0);
         if (spawnInfo.GetHighGuid() == HIGHGUID_UNIT)
             m_map.GetPersistentState()->SaveCreatureRespawnTime(spawnInfo.GetDbGuid(), 0);
         spawnInfo.ConstructForMap(m_map);
     }
+
+    for (auto itr = m_spawns.begin(); itr != m_spawns.end();)
+    {
+        if (itr->second.IsUsed())
+            itr = m_spawns.erase(itr);
+        else
+            ++itr;
+    }
 }
 
 void SpawnManager::Update()
 {
+    // only due entries are visited, the ones failing to spawn (linking) stay due and are retried next tick
     auto now = m_map.GetCurrentClockTime();
-    for (auto itr = m_spawns.begin(); itr != m_spawns.end();)
+    for (auto itr = m_spawns.begin(); itr != m_spawns.end() && itr->first <= now;)
     {
-        auto& spawnInfo = *itr;
-        if (spawnInfo.IsUsed() ||
-            (spawnInfo.GetRespawnTime() <= now && spawnInfo.ConstructForMap(m_map)))
+        auto& spawnInfo = itr->second;
+        // spawning can add or reschedule other entries, never this one as it is in use meanwhile
+        if (spawnInfo.IsUsed() || spawnInfo.ConstructForMap(m_map))
             itr = m_spawns.erase(itr);
         else
             ++itr;
@@ -170,8 +169,12 @@ void SpawnManager::Update()
 std::string SpawnManager::GetRespawnList()
 {
     std::string output = "";
-    for (auto& data : m_spawns)
+    for (auto& spawn : m_spawns)
     {
+        SpawnInfo const& data = spawn.second;
+        if (data.IsUsed())
+            continue;
+
         output += "DBGuid: " + std::to_string(data.GetDbGuid()) + "HighGuid: " + (data.GetHighGuid() == HIGHGUID_UNIT ? "Creature" : "GameObject") + "Respawn Time ";
         auto diff = (data.GetRespawnTime() - m_map.GetCurrentClockTime()).count();
         if (auto hours = diff / (HOUR * IN_MILLISECONDS))
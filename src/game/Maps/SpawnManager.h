@@ -23,6 +23,7 @@
 #include "Entities/ObjectGuid.h"
 #include "Maps/SpawnGroup.h"
 
+#include <map>
 #include <string>
 
 class Map;
@@ -46,8 +47,6 @@ class SpawnInfo
         bool m_inUse;
 };
 
-bool operator<(SpawnInfo const& lhs, SpawnInfo const& rhs);
-
 class SpawnManager
 {
     public:
@@ -68,12 +67,19 @@ class SpawnManager
         std::string GetRespawnList();
 
         SpawnGroup* GetSpawnGroup(uint32 Id);
+        uint32 GetSpawnGroupCount() const { return uint32(m_spawnGroups.size()); }
 
         void RespawnSpawnGroupsInVicinity(Position pos, float range);
     private:
         Map& m_map;
 
-        std::vector<SpawnInfo> m_spawns; // must only be erased from in Update
+        typedef std::multimap<TimePoint, SpawnInfo> SpawnQueue;
+
+        SpawnQueue::iterator FindSpawn(uint32 dbguid, HighGuid high);
+        void Respawn(uint32 dbguid, HighGuid high, uint32 respawnDelay);
+        void Schedule(SpawnQueue::iterator itr, TimePoint const& when);
+
+        SpawnQueue m_spawns; // ordered by respawn time, must only be erased from in Update and RespawnAll
         std::map<uint32, SpawnGroup*> m_spawnGroups;
 };
 
@@ -1050,14 +1050,23 @@ void PoolManager::LoadFromDB()
                     sLog.outErrorDb("Pool Template Id (%u) is empty.", pool_entry);
     }
 
+    // new map states only need to look at the pools of their own map
+    for (uint16 pool_entry = 0; pool_entry < mPoolTemplate.size(); ++pool_entry)
+        if (MapEntry const* mapEntry = mPoolTemplate[pool_entry].mapEntry)
+            mMapPools[mapEntry->MapID].push_back(pool_entry);
+
     sLog.outString();
 }
 
 // The initialize method will spawn all pools not in an event and not in another pool
 void PoolManager::Initialize(MapPersistentState* state)
 {
+    auto itr = mMapPools.find(state->GetMapId());
+    if (itr == mMapPools.end())
+        return;
+
     // spawn pools for expected map or for not initialized shared pools state for non-instanceable maps
-    for (uint16 pool_entry = 0; pool_entry < mPoolTemplate.size(); ++pool_entry)
+    for (uint16 pool_entry : itr->second)
         if (mPoolTemplate[pool_entry].AutoSpawn)
             InitSpawnPool(*state, pool_entry);
 }
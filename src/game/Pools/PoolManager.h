@@ -199,6 +199,7 @@ class PoolManager
         typedef std::map<uint32, uint16> SearchMap;
 
         PoolTemplateDataMap mPoolTemplate;
+        std::unordered_map<uint32 /*mapId*/, std::vector<uint16> > mMapPools; // pools with spawns on the map, lowest id first
         PoolGroupCreatureMap mPoolCreatureGroups;
         PoolGroupGameObjectMap mPoolGameobjectGroups;
         PoolGroupPoolMap mPoolPoolGroups;
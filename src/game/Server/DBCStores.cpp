@@ -24,10 +24,13 @@
 #include "Globals/Locales.h"
 #include "Globals/SharedDefines.h"
 #include "Server/SQLStorages.h"
+#include "World/StartupLoader.h"
 
 #include "DBCfmt.h"
 
+#include <atomic>
 #include <map>
+#include <mutex>
 
 typedef std::map<uint32, uint32> AreaIDByAreaFlag;
 typedef std::map<uint32, uint32> AreaFlagByMapID;
@@ -191,43 +194,67 @@ static bool LoadDBC_assert_print(uint32 fsize, uint32 rsize, const std::string&
     return false;
 }
 
+// shared by the load steps of LoadDBCStores, which may run on several threads
+struct DBCLoadState
+{
+    DBCLoadState(std::string const& path, uint32 fileCount) : dbcPath(path), availableDbcLocales(0xFFFFFFFF), bar(fileCount) {}
+
+    std::string dbcPath;
+    std::atomic<uint32> availableDbcLocales;                // bitmask for index of fullLocaleNameList
+    std::mutex lock;                                        // guards bar and badFiles
+    BarGoLink bar;
+    StoreProblemList badFiles;
+};
+
 template<class T>
-inline void LoadDBC(uint32& availableDbcLocales, BarGoLink& bar, StoreProblemList& errlist, DBCStorage<T>& storage, const std::string& dbc_path, const std::string& filename)
+inline void LoadDBC(DBCLoadState& state, DBCStorage<T>& storage, const std::string& filename)
 {
     // compatibility format and C++ structure sizes
     MANGOS_ASSERT(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()) == sizeof(T) || LoadDBC_assert_print(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()), sizeof(T), filename));
 
-    std::string dbc_filename = dbc_path + filename;
+    std::string dbc_filename = state.dbcPath + filename;
     if (storage.Load(dbc_filename.c_str()))
     {
-        bar.step();
+        {
+            std::lock_guard<std::mutex> guard(state.lock);
+            state.bar.step();
+        }
+
         for (uint8 i = 0; fullLocaleNameList[i].name; ++i)
         {
-            if (!(availableDbcLocales & (1 << i)))
+            if (!(state.availableDbcLocales & (1 << i)))
                 continue;
 
-            std::string dbc_filename_loc = dbc_path + fullLocaleNameList[i].name + "/" + filename;
+            std::string dbc_filename_loc = state.dbcPath + fullLocaleNameList[i].name + "/" + filename;
             if (!storage.LoadStringsFrom(dbc_filename_loc.c_str()))
-                availableDbcLocales &= ~(1 << i);           // mark as not available for speedup next checks
+                state.availableDbcLocales &= ~(1 << i);     // mark as not available for speedup next checks
         }
     }
     else
     {
         // sort problematic dbc to (1) non compatible and (2) nonexistent
+        std::string problem = dbc_filename;
         FILE* f = fopen(dbc_filename.c_str(), "rb");
         if (f)
         {
             char buf[100];
             snprintf(buf, 100, " (exist, but have %u fields instead " SIZEFMTD ") Wrong client version DBC file?", storage.GetFieldCount(), strlen(storage.GetFormat()));
-            errlist.push_back(dbc_filename + buf);
+            problem += buf;
             fclose(f);
         }
-        else
-            errlist.push_back(dbc_filename);
+
+        std::lock_guard<std::mutex> guard(state.lock);
+        state.badFiles.push_back(problem);
     }
 }
 
-void LoadDBCStores(const std::string& dataPath)
+template<class T>
+inline void AddDBCLoadStep(StartupLoader& loader, DBCLoadState& state, DBCStorage<T>& storage, char const* filename)
+{
+    loader.AddStep(filename, [&state, &storage, filename]() { LoadDBC(state, storage, filename); });
+}
+
+void LoadDBCStores(const std::string& dataPath, uint32 threads)
 {
     std::string dbcPath = dataPath + "dbc/";
 
@@ -240,14 +267,78 @@ void LoadDBCStores(const std::string& dataPath)
 
     const uint32 DBCFilesCount = 52;
 
-    BarGoLink bar(DBCFilesCount);
-
-    StoreProblemList bad_dbc_files;
-
-    // bitmask for index of fullLocaleNameList
-    uint32 availableDbcLocales = 0xFFFFFFFF;
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sAreaStore,                dbcPath, "AreaTable.dbc");
+    DBCLoadState state(dbcPath, DBCFilesCount);
+
+    // the files are independent, only the fill loops below need more than one store
+    StartupLoader loader("DBC stores", threads);
+    AddDBCLoadStep(loader, state, sAreaStore,                       "AreaTable.dbc");
+    AddDBCLoadStep(loader, state, sAreaTriggerStore,                "AreaTrigger.dbc");
+    AddDBCLoadStep(loader, state, sAuctionHouseStore,               "AuctionHouse.dbc");
+    AddDBCLoadStep(loader, state, sBankBagSlotPricesStore,          "BankBagSlotPrices.dbc");
+    AddDBCLoadStep(loader, state, sCharStartOutfitStore,            "CharStartOutfit.dbc");
+    AddDBCLoadStep(loader, state, sChatChannelsStore,               "ChatChannels.dbc");
+    AddDBCLoadStep(loader, state, sCharacterFacialHairStylesStore,  "CharacterFacialHairStyles.dbc");
+    AddDBCLoadStep(loader, state, sCharSectionsStore,               "CharSections.dbc");
+    AddDBCLoadStep(loader, state, sChrClassesStore,                 "ChrClasses.dbc");
+    AddDBCLoadStep(loader, state, sChrRacesStore,                   "ChrRaces.dbc");
+    AddDBCLoadStep(loader, state, sCinematicCameraStore,            "CinematicCamera.dbc");
+    AddDBCLoadStep(loader, state, sCinematicSequencesStore,         "CinematicSequences.dbc");
+    AddDBCLoadStep(loader, state, sCreatureDisplayInfoStore,        "CreatureDisplayInfo.dbc");
+    AddDBCLoadStep(loader, state, sCreatureDisplayInfoExtraStore,   "CreatureDisplayInfoExtra.dbc");
+    AddDBCLoadStep(loader, state, sCreatureFamilyStore,             "CreatureFamily.dbc");
+    AddDBCLoadStep(loader, state, sCreatureModelDataStore,          "CreatureModelData.dbc");
+    AddDBCLoadStep(loader, state, sCreatureSpellDataStore,          "CreatureSpellData.dbc");
+    AddDBCLoadStep(loader, state, sCreatureTypeStore,               "CreatureType.dbc");
+    AddDBCLoadStep(loader, state, sDurabilityCostsStore,            "DurabilityCosts.dbc");
+    AddDBCLoadStep(loader, state, sDurabilityQualityStore,          "DurabilityQuality.dbc");
+    AddDBCLoadStep(loader, state, sEmotesStore,                     "Emotes.dbc");
+    AddDBCLoadStep(loader, state, sEmotesTextStore,                 "EmotesText.dbc");
+    AddDBCLoadStep(loader, state, sFactionStore,                    "Faction.dbc");
+#ifdef ENABLE_PLAYERBOTS
+    AddDBCLoadStep(loader, state, sEmotesTextSoundStore,            "EmotesTextSound.dbc");
+#endif
+    AddDBCLoadStep(loader, state, sFactionTemplateStore,            "FactionTemplate.dbc");
+    AddDBCLoadStep(loader, state, sGameObjectArtKitStore,           "GameObjectArtKit.dbc");
+    AddDBCLoadStep(loader, state, sGameObjectDisplayInfoStore,      "GameObjectDisplayInfo.dbc");
+    AddDBCLoadStep(loader, state, sGMSurveyCurrentSurveyStore,      "GMSurveyCurrentSurvey.dbc");
+    AddDBCLoadStep(loader, state, sGMSurveyQuestionsStore,          "GMSurveyQuestions.dbc");
+    AddDBCLoadStep(loader, state, sGMSurveySurveysStore,            "GMSurveySurveys.dbc");
+    AddDBCLoadStep(loader, state, sGMTicketCategoryStore,           "GMTicketCategory.dbc");
+    AddDBCLoadStep(loader, state, sItemBagFamilyStore,              "ItemBagFamily.dbc");
+    AddDBCLoadStep(loader, state, sItemClassStore,                  "ItemClass.dbc");
+    // AddDBCLoadStep(loader, state, sItemDisplayInfoStore,            "ItemDisplayInfo.dbc");     -- not used currently
+    // AddDBCLoadStep(loader, state, sItemCondExtCostsStore,           "ItemCondExtCosts.dbc");
+    AddDBCLoadStep(loader, state, sItemRandomPropertiesStore,       "ItemRandomProperties.dbc");
+    AddDBCLoadStep(loader, state, sItemSetStore,                    "ItemSet.dbc");
+    AddDBCLoadStep(loader, state, sLiquidTypeStore,                 "LiquidType.dbc");
+    AddDBCLoadStep(loader, state, sLockStore,                       "Lock.dbc");
+    AddDBCLoadStep(loader, state, sMailTemplateStore,               "MailTemplate.dbc");
+    AddDBCLoadStep(loader, state, sMapStore,                        "Map.dbc");
+    AddDBCLoadStep(loader, state, sQuestSortStore,                  "QuestSort.dbc");
+    AddDBCLoadStep(loader, state, sSkillLineStore,                  "SkillLine.dbc");
+    AddDBCLoadStep(loader, state, sSkillLineAbilityStore,           "SkillLineAbility.dbc");
+    AddDBCLoadStep(loader, state, sSkillRaceClassInfoStore,         "SkillRaceClassInfo.dbc");
+    AddDBCLoadStep(loader, state, sSkillTiersStore,                 "SkillTiers.dbc");
+    AddDBCLoadStep(loader, state, sSoundEntriesStore,               "SoundEntries.dbc");
+    AddDBCLoadStep(loader, state, sSpellCastTimesStore,             "SpellCastTimes.dbc");
+    AddDBCLoadStep(loader, state, sSpellDurationStore,              "SpellDuration.dbc");
+    AddDBCLoadStep(loader, state, sSpellFocusObjectStore,           "SpellFocusObject.dbc");
+    AddDBCLoadStep(loader, state, sSpellItemEnchantmentStore,       "SpellItemEnchantment.dbc");
+    AddDBCLoadStep(loader, state, sSpellRadiusStore,                "SpellRadius.dbc");
+    AddDBCLoadStep(loader, state, sSpellRangeStore,                 "SpellRange.dbc");
+    AddDBCLoadStep(loader, state, sSpellShapeshiftFormStore,        "SpellShapeshiftForm.dbc");
+    AddDBCLoadStep(loader, state, sStableSlotPricesStore,           "StableSlotPrices.dbc");
+    AddDBCLoadStep(loader, state, sTalentStore,                     "Talent.dbc");
+    AddDBCLoadStep(loader, state, sTalentTabStore,                  "TalentTab.dbc");
+    AddDBCLoadStep(loader, state, sTaxiNodesStore,                  "TaxiNodes.dbc");
+    AddDBCLoadStep(loader, state, sTaxiPathStore,                   "TaxiPath.dbc");
+    AddDBCLoadStep(loader, state, sTaxiPathNodeStore,               "TaxiPathNode.dbc");
+    AddDBCLoadStep(loader, state, sTransportAnimationStore,         "TransportAnimation.dbc");
+    AddDBCLoadStep(loader, state, sWorldMapAreaStore,               "WorldMapArea.dbc");
+    AddDBCLoadStep(loader, state, sWMOAreaTableStore,               "WMOAreaTable.dbc");
+    AddDBCLoadStep(loader, state, sWorldMapOverlayStore,            "WorldMapOverlay.dbc");
+    // AddDBCLoadStep(loader, state, sWorldSafeLocsStore,              "WorldSafeLocs.dbc");
+    loader.Run();
 
     // must be after sAreaStore loading
     for (uint32 i = 1; i <= sAreaStore.GetNumRows(); ++i)   // areaid numbered from 1
@@ -263,39 +354,16 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sAreaTriggerStore,         dbcPath, "AreaTrigger.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sAuctionHouseStore,        dbcPath, "AuctionHouse.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sBankBagSlotPricesStore,   dbcPath, "BankBagSlotPrices.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCharStartOutfitStore,     dbcPath, "CharStartOutfit.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sChatChannelsStore,        dbcPath, "ChatChannels.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCharacterFacialHairStylesStore, dbcPath, "CharacterFacialHairStyles.dbc");
     for (uint32 i = 0; i < sCharacterFacialHairStylesStore.GetNumRows(); ++i)
         if (CharacterFacialHairStylesEntry const* entry = sCharacterFacialHairStylesStore.LookupEntry(i))
             if (entry->RaceID && ((1 << (entry->RaceID - 1)) & RACEMASK_ALL_PLAYABLE) != 0) // ignore nonplayable races
                 sCharFacialHairMap.insert({ entry->RaceID | (entry->SexID << 8) | (entry->VariationID << 16), entry });
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCharSectionsStore, dbcPath, "CharSections.dbc");
     for (uint32 i = 0; i < sCharSectionsStore.GetNumRows(); ++i)
         if (CharSectionsEntry const* entry = sCharSectionsStore.LookupEntry(i))
             if (entry->Race && ((1 << (entry->Race - 1)) & RACEMASK_ALL_PLAYABLE) != 0) //ignore Nonplayable races
                 sCharSectionMap.emplace(uint8(entry->BaseSection) | (uint8(entry->Gender) << 8) | (uint8(entry->Race) << 16), entry);
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sChrClassesStore,          dbcPath, "ChrClasses.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sChrRacesStore,            dbcPath, "ChrRaces.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCinematicCameraStore,     dbcPath, "CinematicCamera.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCinematicSequencesStore,  dbcPath, "CinematicSequences.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureDisplayInfoStore, dbcPath, "CreatureDisplayInfo.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureDisplayInfoExtraStore, dbcPath, "CreatureDisplayInfoExtra.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureFamilyStore,      dbcPath, "CreatureFamily.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureModelDataStore,   dbcPath, "CreatureModelData.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureSpellDataStore,   dbcPath, "CreatureSpellData.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureTypeStore,        dbcPath, "CreatureType.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sDurabilityCostsStore,     dbcPath, "DurabilityCosts.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sDurabilityQualityStore,   dbcPath, "DurabilityQuality.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sEmotesStore,              dbcPath, "Emotes.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sEmotesTextStore,          dbcPath, "EmotesText.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sFactionStore,             dbcPath, "Faction.dbc");
     for (uint32 i = 0; i < sFactionStore.GetNumRows(); ++i)
     {
         FactionEntry const* faction = sFactionStore.LookupEntry(i);
@@ -307,38 +375,11 @@ void LoadDBCStores(const std::string& dataPath)
     }
 
 #ifdef ENABLE_PLAYERBOTS
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sEmotesTextSoundStore, dbcPath, "EmotesTextSound.dbc");
     for (uint32 i = 0; i < sEmotesTextSoundStore.GetNumRows(); ++i)
         if (EmotesTextSoundEntry const* entry = sEmotesTextSoundStore.LookupEntry(i))
             sEmotesTextSoundMap[EmotesTextSoundKey(entry->EmotesTextId, entry->RaceId, entry->SexId)] = entry;
 #endif
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sFactionTemplateStore,     dbcPath, "FactionTemplate.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGameObjectArtKitStore,    dbcPath, "GameObjectArtKit.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGameObjectDisplayInfoStore, dbcPath, "GameObjectDisplayInfo.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGMSurveyCurrentSurveyStore,  dbcPath, "GMSurveyCurrentSurvey.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGMSurveyQuestionsStore,  dbcPath, "GMSurveyQuestions.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGMSurveySurveysStore,  dbcPath, "GMSurveySurveys.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGMTicketCategoryStore, dbcPath, "GMTicketCategory.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemBagFamilyStore,       dbcPath, "ItemBagFamily.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemClassStore,           dbcPath, "ItemClass.dbc");
-    // LoadDBC(availableDbcLocales,bar,bad_dbc_files,sItemDisplayInfoStore,     dbcPath,"ItemDisplayInfo.dbc");     -- not used currently
-    // LoadDBC(availableDbcLocales,bar,bad_dbc_files,sItemCondExtCostsStore,    dbcPath,"ItemCondExtCosts.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemRandomPropertiesStore, dbcPath, "ItemRandomProperties.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemSetStore,             dbcPath, "ItemSet.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sLiquidTypeStore,          dbcPath, "LiquidType.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sLockStore,                dbcPath, "Lock.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sMailTemplateStore,        dbcPath, "MailTemplate.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sMapStore,                 dbcPath, "Map.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sQuestSortStore,           dbcPath, "QuestSort.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSkillLineStore,           dbcPath, "SkillLine.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSkillLineAbilityStore,    dbcPath, "SkillLineAbility.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSkillRaceClassInfoStore,  dbcPath, "SkillRaceClassInfo.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSkillTiersStore,          dbcPath, "SkillTiers.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSoundEntriesStore,        dbcPath, "SoundEntries.dbc");
-
     for (uint32 j = 0; j < sSkillLineAbilityStore.GetNumRows(); ++j)
     {
         SkillLineAbilityEntry const* skillLine = sSkillLineAbilityStore.LookupEntry(j);
@@ -374,10 +415,6 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellCastTimesStore,      dbcPath, "SpellCastTimes.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellDurationStore,       dbcPath, "SpellDuration.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellFocusObjectStore,    dbcPath, "SpellFocusObject.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellItemEnchantmentStore, dbcPath, "SpellItemEnchantment.dbc");
     //for (uint32 i = 0; i < sSpellItemEnchantmentStore.GetNumRows(); ++i)
     //{
     //    SpellItemEnchantmentEntry const* enchantEntry = sSpellItemEnchantmentStore.LookupEntry(i);
@@ -390,11 +427,6 @@ void LoadDBCStores(const std::string& dataPath)
     //                sLog.outErrorDb("Spell ID %u found in spell item enchant %u does not exist.", enchantEntry->spellid[k], i);
     //    }
     //}
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellRadiusStore,         dbcPath, "SpellRadius.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellRangeStore,          dbcPath, "SpellRange.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellShapeshiftFormStore, dbcPath, "SpellShapeshiftForm.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sStableSlotPricesStore,    dbcPath, "StableSlotPrices.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTalentStore,              dbcPath, "Talent.dbc");
 
     // create talent spells set
     for (unsigned int i = 0; i < sTalentStore.GetNumRows(); ++i)
@@ -406,8 +438,6 @@ void LoadDBCStores(const std::string& dataPath)
                 sTalentSpellPosMap[talentInfo->RankID[j]] = TalentSpellPos(i, j);
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTalentTabStore,           dbcPath, "TalentTab.dbc");
-
     // prepare fast data access to bit pos of talent ranks for use at inspecting
     {
         // fill table by amount of talent ranks and fill sTalentTabBitSizeInInspect
@@ -473,16 +503,12 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTaxiNodesStore,           dbcPath, "TaxiNodes.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTaxiPathStore,            dbcPath, "TaxiPath.dbc");
     for (uint32 i = 1; i < sTaxiPathStore.GetNumRows(); ++i)
         if (TaxiPathEntry const* entry = sTaxiPathStore.LookupEntry(i))
             sTaxiPathSetBySource[entry->from][entry->to] = TaxiPathBySourceAndDestination(entry->ID, entry->price);
     uint32 pathCount = sTaxiPathStore.GetNumRows();
 
     //## TaxiPathNode.dbc ## Loaded only for initialization different structures
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTaxiPathNodeStore,        dbcPath, "TaxiPathNode.dbc");
     // Calculate path nodes count
     std::vector<uint32> pathLength;
     pathLength.resize(pathCount);                           // 0 and some other indexes not used
@@ -543,10 +569,6 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTransportAnimationStore,  dbcPath, "TransportAnimation.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sWorldMapAreaStore,        dbcPath, "WorldMapArea.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sWMOAreaTableStore,        dbcPath, "WMOAreaTable.dbc");
     for (uint32 i = 0; i < sWMOAreaTableStore.GetNumRows(); ++i)
     {
         if (WMOAreaTableEntry const* entry = sWMOAreaTableStore.LookupEntry(i))
@@ -554,23 +576,21 @@ void LoadDBCStores(const std::string& dataPath)
             sWMOAreaInfoByTripple[WMOAreaTableTripple(entry->rootId, entry->adtId, entry->groupId)].push_back(entry);
         }
     }
-    LoadDBC(availableDbcLocales,bar,bad_dbc_files,sWorldMapOverlayStore,     dbcPath,"WorldMapOverlay.dbc");
-    // LoadDBC(availableDbcLocales, bar, bad_dbc_files, sWorldSafeLocsStore,       dbcPath, "WorldSafeLocs.dbc");
 
     // error checks
-    if (bad_dbc_files.size() >= DBCFilesCount)
+    if (state.badFiles.size() >= DBCFilesCount)
     {
         sLog.outError("\nIncorrect DataDir value in mangosd.conf or ALL required *.dbc files (%d) not found by path: %sdbc", DBCFilesCount, dataPath.c_str());
         Log::WaitBeforeContinueIfNeed();
         exit(1);
     }
-    if (!bad_dbc_files.empty())
+    if (!state.badFiles.empty())
     {
         std::string str;
-        for (auto& bad_dbc_file : bad_dbc_files)
+        for (auto& bad_dbc_file : state.badFiles)
             str += bad_dbc_file + "\n";
 
-        sLog.outError("\nSome required *.dbc files (%u from %d) not found or not compatible:\n%s", (uint32)bad_dbc_files.size(), DBCFilesCount, str.c_str());
+        sLog.outError("\nSome required *.dbc files (%u from %d) not found or not compatible:\n%s", (uint32)state.badFiles.size(), DBCFilesCount, str.c_str());
         Log::WaitBeforeContinueIfNeed();
         exit(1);
     }
@@ -34,16 +34,94 @@ OpcodeHandler const OpcodeStore::emptyHandler =
 };
 
 
-OpcodeStore::OpcodeStore()
+OpcodeStore::OpcodeStore() : m_statisticsEnabled(false)
 {
-    /// Build Opcodes map
+    for (OpcodeHandler& opcode : m_opcodes)
+    {
+        opcode = emptyHandler;
+        opcode.name = nullptr;
+    }
+
+    ResetStatistics();
+
+    /// Build Opcodes table
     BuildOpcodeList();
 }
 
 OpcodeStore::~OpcodeStore()
 {
-    /// Clear Opcodes
-    mOpcodeMap.clear();
+}
+
+void OpcodeStore::RecordPacket(uint16 opcode, size_t bytes, uint32 timeUs)
+{
+    if (opcode >= NUM_MSG_TYPES)
+        return;
+
+    uint32 bucket = 0;
+    while (bucket < OPCODE_TIME_BUCKETS - 1 && (timeUs >> bucket))
+        ++bucket;
+
+    OpcodeStatistics& stats = m_statistics[opcode];
+    stats.count.fetch_add(1, std::memory_order_relaxed);
+    stats.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    stats.timeUs.fetch_add(timeUs, std::memory_order_relaxed);
+    stats.timeBuckets[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void OpcodeStore::ResetStatistics()
+{
+    for (OpcodeStatistics& stats : m_statistics)
+    {
+        stats.count = 0;
+        stats.bytes = 0;
+        stats.timeUs = 0;
+        for (std::atomic<uint32>& bucket : stats.timeBuckets)
+            bucket = 0;
+    }
+}
+
+std::vector<OpcodeStatisticsSummary> OpcodeStore::GetStatistics() const
+{
+    std::vector<OpcodeStatisticsSummary> result;
+    for (uint32 i = 0; i < NUM_MSG_TYPES; ++i)
+    {
+        OpcodeStatistics const& stats = m_statistics[i];
+        uint32 buckets[OPCODE_TIME_BUCKETS];
+        uint64 count = 0;
+        for (uint32 j = 0; j < OPCODE_TIME_BUCKETS; ++j)
+        {
+            buckets[j] = stats.timeBuckets[j].load(std::memory_order_relaxed);
+            count += buckets[j];
+        }
+
+        if (!count)
+            continue;
+
+        OpcodeStatisticsSummary summary;
+        summary.opcode = uint16(i);
+        summary.count = count;
+        summary.bytes = stats.bytes.load(std::memory_order_relaxed);
+        summary.timeUs = stats.timeUs.load(std::memory_order_relaxed);
+        summary.p50Us = 0;
+        summary.p99Us = 0;
+
+        // bucket j holds times below 2^j us, report that bound
+        uint64 seen = 0;
+        for (uint32 j = 0; j < OPCODE_TIME_BUCKETS; ++j)
+        {
+            seen += buckets[j];
+            if (!summary.p50Us && seen * 2 >= count)
+                summary.p50Us = 1u << j;
+            if (seen * 100 >= count * 99)
+            {
+                summary.p99Us = 1u << j;
+                break;
+            }
+        }
+
+        result.push_back(summary);
+    }
+    return result;
 }
 
 
@@ -231,29 +309,29 @@ void OpcodeStore::BuildOpcodeList()
     /*0x0B2*/  StoreOpcode(CMSG_GAMEOBJ_CHAIR_USE_OBSOLETE,   "CMSG_GAMEOBJ_CHAIR_USE_OBSOLETE",  STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x0B3*/  StoreOpcode(SMSG_GAMEOBJECT_CUSTOM_ANIM,       "SMSG_GAMEOBJECT_CUSTOM_ANIM",      STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x0B4*/  StoreOpcode(CMSG_AREATRIGGER,                  "CMSG_AREATRIGGER",                 STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE,      &WorldSession::HandleAreaTriggerOpcode);
-    /*0x0B5*/  StoreOpcode(MSG_MOVE_START_FORWARD,            "MSG_MOVE_START_FORWARD",           STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
-    /*0x0B6*/  StoreOpcode(MSG_MOVE_START_BACKWARD,           "MSG_MOVE_START_BACKWARD",          STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
-    /*0x0B7*/  StoreOpcode(MSG_MOVE_STOP,                     "MSG_MOVE_STOP",                    STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
-    /*0x0B8*/  StoreOpcode(MSG_MOVE_START_STRAFE_LEFT,        "MSG_MOVE_START_STRAFE_LEFT",       STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
-    /*0x0B9*/  StoreOpcode(MSG_MOVE_START_STRAFE_RIGHT,       "MSG_MOVE_START_STRAFE_RIGHT",      STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
-    /*0x0BA*/  StoreOpcode(MSG_MOVE_STOP_STRAFE,              "MSG_MOVE_STOP_STRAFE",             STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
-    /*0x0BB*/  StoreOpcode(MSG_MOVE_JUMP,                     "MSG_MOVE_JUMP",                    STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
-    /*0x0BC*/  StoreOpcode(MSG_MOVE_START_TURN_LEFT,          "MSG_MOVE_START_TURN_LEFT",         STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
-    /*0x0BD*/  StoreOpcode(MSG_MOVE_START_TURN_RIGHT,         "MSG_MOVE_START_TURN_RIGHT",        STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
-    /*0x0BE*/  StoreOpcode(MSG_MOVE_STOP_TURN,                "MSG_MOVE_STOP_TURN",               STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
-    /*0x0BF*/  StoreOpcode(MSG_MOVE_START_PITCH_UP,           "MSG_MOVE_START_PITCH_UP",          STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
-    /*0x0C0*/  StoreOpcode(MSG_MOVE_START_PITCH_DOWN,         "MSG_MOVE_START_PITCH_DOWN",        STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
-    /*0x0C1*/  StoreOpcode(MSG_MOVE_STOP_PITCH,               "MSG_MOVE_STOP_PITCH",              STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
-    /*0x0C2*/  StoreOpcode(MSG_MOVE_SET_RUN_MODE,             "MSG_MOVE_SET_RUN_MODE",            STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
-    /*0x0C3*/  StoreOpcode(MSG_MOVE_SET_WALK_MODE,            "MSG_MOVE_SET_WALK_MODE",           STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
+    /*0x0B5*/  StoreOpcode(MSG_MOVE_START_FORWARD,            "MSG_MOVE_START_FORWARD",           STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
+    /*0x0B6*/  StoreOpcode(MSG_MOVE_START_BACKWARD,           "MSG_MOVE_START_BACKWARD",          STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
+    /*0x0B7*/  StoreOpcode(MSG_MOVE_STOP,                     "MSG_MOVE_STOP",                    STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
+    /*0x0B8*/  StoreOpcode(MSG_MOVE_START_STRAFE_LEFT,        "MSG_MOVE_START_STRAFE_LEFT",       STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
+    /*0x0B9*/  StoreOpcode(MSG_MOVE_START_STRAFE_RIGHT,       "MSG_MOVE_START_STRAFE_RIGHT",      STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
+    /*0x0BA*/  StoreOpcode(MSG_MOVE_STOP_STRAFE,              "MSG_MOVE_STOP_STRAFE",             STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
+    /*0x0BB*/  StoreOpcode(MSG_MOVE_JUMP,                     "MSG_MOVE_JUMP",                    STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
+    /*0x0BC*/  StoreOpcode(MSG_MOVE_START_TURN_LEFT,          "MSG_MOVE_START_TURN_LEFT",         STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
+    /*0x0BD*/  StoreOpcode(MSG_MOVE_START_TURN_RIGHT,         "MSG_MOVE_START_TURN_RIGHT",        STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
+    /*0x0BE*/  StoreOpcode(MSG_MOVE_STOP_TURN,                "MSG_MOVE_STOP_TURN",               STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
+    /*0x0BF*/  StoreOpcode(MSG_MOVE_START_PITCH_UP,           "MSG_MOVE_START_PITCH_UP",          STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
+    /*0x0C0*/  StoreOpcode(MSG_MOVE_START_PITCH_DOWN,         "MSG_MOVE_START_PITCH_DOWN",        STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
+    /*0x0C1*/  StoreOpcode(MSG_MOVE_STOP_PITCH,               "MSG_MOVE_STOP_PITCH",              STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
+    /*0x0C2*/  StoreOpcode(MSG_MOVE_SET_RUN_MODE,             "MSG_MOVE_SET_RUN_MODE",            STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
+    /*0x0C3*/  StoreOpcode(MSG_MOVE_SET_WALK_MODE,            "MSG_MOVE_SET_WALK_MODE",           STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
     /*0x0C4*/  StoreOpcode(MSG_MOVE_TOGGLE_LOGGING,           "MSG_MOVE_TOGGLE_LOGGING",          STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x0C5*/  StoreOpcode(MSG_MOVE_TELEPORT,                 "MSG_MOVE_TELEPORT",                STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x0C6*/  StoreOpcode(MSG_MOVE_TELEPORT_CHEAT,           "MSG_MOVE_TELEPORT_CHEAT",          STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
-    /*0x0C7*/  StoreOpcode(MSG_MOVE_TELEPORT_ACK,             "MSG_MOVE_TELEPORT_ACK",            STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMoveTeleportAckOpcode);
+    /*0x0C7*/  StoreOpcode(MSG_MOVE_TELEPORT_ACK,             "MSG_MOVE_TELEPORT_ACK",            STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMoveTeleportAckOpcode);
     /*0x0C8*/  StoreOpcode(MSG_MOVE_TOGGLE_FALL_LOGGING,      "MSG_MOVE_TOGGLE_FALL_LOGGING",     STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
-    /*0x0C9*/  StoreOpcode(MSG_MOVE_FALL_LAND,                "MSG_MOVE_FALL_LAND",               STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
-    /*0x0CA*/  StoreOpcode(MSG_MOVE_START_SWIM,               "MSG_MOVE_START_SWIM",              STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
-    /*0x0CB*/  StoreOpcode(MSG_MOVE_STOP_SWIM,                "MSG_MOVE_STOP_SWIM",               STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
+    /*0x0C9*/  StoreOpcode(MSG_MOVE_FALL_LAND,                "MSG_MOVE_FALL_LAND",               STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
+    /*0x0CA*/  StoreOpcode(MSG_MOVE_START_SWIM,               "MSG_MOVE_START_SWIM",              STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
+    /*0x0CB*/  StoreOpcode(MSG_MOVE_STOP_SWIM,                "MSG_MOVE_STOP_SWIM",               STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
     /*0x0CC*/  StoreOpcode(MSG_MOVE_SET_RUN_SPEED_CHEAT,      "MSG_MOVE_SET_RUN_SPEED_CHEAT",     STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x0CD*/  StoreOpcode(MSG_MOVE_SET_RUN_SPEED,            "MSG_MOVE_SET_RUN_SPEED",           STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x0CE*/  StoreOpcode(MSG_MOVE_SET_RUN_BACK_SPEED_CHEAT, "MSG_MOVE_SET_RUN_BACK_SPEED_CHEAT", STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
@@ -268,8 +346,8 @@ void OpcodeStore::BuildOpcodeList()
     /*0x0D7*/  StoreOpcode(MSG_MOVE_SET_TURN_RATE_CHEAT,      "MSG_MOVE_SET_TURN_RATE_CHEAT",     STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x0D8*/  StoreOpcode(MSG_MOVE_SET_TURN_RATE,            "MSG_MOVE_SET_TURN_RATE",           STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x0D9*/  StoreOpcode(MSG_MOVE_TOGGLE_COLLISION_CHEAT,   "MSG_MOVE_TOGGLE_COLLISION_CHEAT",  STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
-    /*0x0DA*/  StoreOpcode(MSG_MOVE_SET_FACING,               "MSG_MOVE_SET_FACING",              STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
-    /*0x0DB*/  StoreOpcode(MSG_MOVE_SET_PITCH,                "MSG_MOVE_SET_PITCH",               STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
+    /*0x0DA*/  StoreOpcode(MSG_MOVE_SET_FACING,               "MSG_MOVE_SET_FACING",              STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
+    /*0x0DB*/  StoreOpcode(MSG_MOVE_SET_PITCH,                "MSG_MOVE_SET_PITCH",               STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
     /*0x0DC*/  StoreOpcode(MSG_MOVE_WORLDPORT_ACK,            "MSG_MOVE_WORLDPORT_ACK",           STATUS_TRANSFER,  PROCESS_THREADUNSAFE, &WorldSession::HandleMoveWorldportAckOpcode);
     /*0x0DD*/  StoreOpcode(SMSG_MONSTER_MOVE,                 "SMSG_MONSTER_MOVE",                STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x0DE*/  StoreOpcode(SMSG_MOVE_WATER_WALK,              "SMSG_MOVE_WATER_WALK",             STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -277,26 +355,26 @@ void OpcodeStore::BuildOpcodeList()
     /*0x0E0*/  StoreOpcode(MSG_MOVE_SET_RAW_POSITION_ACK,     "MSG_MOVE_SET_RAW_POSITION_ACK",    STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x0E1*/  StoreOpcode(CMSG_MOVE_SET_RAW_POSITION,        "CMSG_MOVE_SET_RAW_POSITION",       STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x0E2*/  StoreOpcode(SMSG_FORCE_RUN_SPEED_CHANGE,       "SMSG_FORCE_RUN_SPEED_CHANGE",      STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x0E3*/  StoreOpcode(CMSG_FORCE_RUN_SPEED_CHANGE_ACK,   "CMSG_FORCE_RUN_SPEED_CHANGE_ACK",  STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleForceSpeedChangeAckOpcodes);
+    /*0x0E3*/  StoreOpcode(CMSG_FORCE_RUN_SPEED_CHANGE_ACK,   "CMSG_FORCE_RUN_SPEED_CHANGE_ACK",  STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleForceSpeedChangeAckOpcodes);
     /*0x0E4*/  StoreOpcode(SMSG_FORCE_RUN_BACK_SPEED_CHANGE,  "SMSG_FORCE_RUN_BACK_SPEED_CHANGE", STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x0E5*/  StoreOpcode(CMSG_FORCE_RUN_BACK_SPEED_CHANGE_ACK, "CMSG_FORCE_RUN_BACK_SPEED_CHANGE_ACK", STATUS_LOGGEDIN, PROCESS_THREADSAFE, &WorldSession::HandleForceSpeedChangeAckOpcodes);
+    /*0x0E5*/  StoreOpcode(CMSG_FORCE_RUN_BACK_SPEED_CHANGE_ACK, "CMSG_FORCE_RUN_BACK_SPEED_CHANGE_ACK", STATUS_LOGGEDIN, PROCESS_MAP_THREAD, &WorldSession::HandleForceSpeedChangeAckOpcodes);
     /*0x0E6*/  StoreOpcode(SMSG_FORCE_SWIM_SPEED_CHANGE,      "SMSG_FORCE_SWIM_SPEED_CHANGE",     STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x0E7*/  StoreOpcode(CMSG_FORCE_SWIM_SPEED_CHANGE_ACK,  "CMSG_FORCE_SWIM_SPEED_CHANGE_ACK", STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleForceSpeedChangeAckOpcodes);
+    /*0x0E7*/  StoreOpcode(CMSG_FORCE_SWIM_SPEED_CHANGE_ACK,  "CMSG_FORCE_SWIM_SPEED_CHANGE_ACK", STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleForceSpeedChangeAckOpcodes);
     /*0x0E8*/  StoreOpcode(SMSG_FORCE_MOVE_ROOT,              "SMSG_FORCE_MOVE_ROOT",             STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x0E9*/  StoreOpcode(CMSG_FORCE_MOVE_ROOT_ACK,          "CMSG_FORCE_MOVE_ROOT_ACK",         STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMoveRootAck);
+    /*0x0E9*/  StoreOpcode(CMSG_FORCE_MOVE_ROOT_ACK,          "CMSG_FORCE_MOVE_ROOT_ACK",         STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMoveRootAck);
     /*0x0EA*/  StoreOpcode(SMSG_FORCE_MOVE_UNROOT,            "SMSG_FORCE_MOVE_UNROOT",           STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x0EB*/  StoreOpcode(CMSG_FORCE_MOVE_UNROOT_ACK,        "CMSG_FORCE_MOVE_UNROOT_ACK",       STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMoveRootAck);
+    /*0x0EB*/  StoreOpcode(CMSG_FORCE_MOVE_UNROOT_ACK,        "CMSG_FORCE_MOVE_UNROOT_ACK",       STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMoveRootAck);
     /*0x0EC*/  StoreOpcode(MSG_MOVE_ROOT,                     "MSG_MOVE_ROOT",                    STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x0ED*/  StoreOpcode(MSG_MOVE_UNROOT,                   "MSG_MOVE_UNROOT",                  STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
-    /*0x0EE*/  StoreOpcode(MSG_MOVE_HEARTBEAT,                "MSG_MOVE_HEARTBEAT",               STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
+    /*0x0EE*/  StoreOpcode(MSG_MOVE_HEARTBEAT,                "MSG_MOVE_HEARTBEAT",               STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
     /*0x0EF*/  StoreOpcode(SMSG_MOVE_KNOCK_BACK,              "SMSG_MOVE_KNOCK_BACK",             STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x0F0*/  StoreOpcode(CMSG_MOVE_KNOCK_BACK_ACK,          "CMSG_MOVE_KNOCK_BACK_ACK",         STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMoveKnockBackAck);
+    /*0x0F0*/  StoreOpcode(CMSG_MOVE_KNOCK_BACK_ACK,          "CMSG_MOVE_KNOCK_BACK_ACK",         STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMoveKnockBackAck);
     /*0x0F1*/  StoreOpcode(MSG_MOVE_KNOCK_BACK,               "MSG_MOVE_KNOCK_BACK",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x0F2*/  StoreOpcode(SMSG_MOVE_FEATHER_FALL,            "SMSG_MOVE_FEATHER_FALL",           STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x0F3*/  StoreOpcode(SMSG_MOVE_NORMAL_FALL,             "SMSG_MOVE_NORMAL_FALL",            STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x0F4*/  StoreOpcode(SMSG_MOVE_SET_HOVER,               "SMSG_MOVE_SET_HOVER",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x0F5*/  StoreOpcode(SMSG_MOVE_UNSET_HOVER,             "SMSG_MOVE_UNSET_HOVER",            STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x0F6*/  StoreOpcode(CMSG_MOVE_HOVER_ACK,               "CMSG_MOVE_HOVER_ACK",              STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMoveFlagChangeOpcode);
+    /*0x0F6*/  StoreOpcode(CMSG_MOVE_HOVER_ACK,               "CMSG_MOVE_HOVER_ACK",              STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMoveFlagChangeOpcode);
     /*0x0F7*/  StoreOpcode(MSG_MOVE_HOVER,                    "MSG_MOVE_HOVER",                   STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x0F8*/  StoreOpcode(CMSG_TRIGGER_CINEMATIC_CHEAT,      "CMSG_TRIGGER_CINEMATIC_CHEAT",     STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x0F9*/  StoreOpcode(CMSG_OPENING_CINEMATIC,            "CMSG_OPENING_CINEMATIC",           STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
@@ -307,7 +385,7 @@ void OpcodeStore::BuildOpcodeList()
     /*0x0FE*/  StoreOpcode(CMSG_TUTORIAL_FLAG,                "CMSG_TUTORIAL_FLAG",               STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleTutorialFlagOpcode);
     /*0x0FF*/  StoreOpcode(CMSG_TUTORIAL_CLEAR,               "CMSG_TUTORIAL_CLEAR",              STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleTutorialClearOpcode);
     /*0x100*/  StoreOpcode(CMSG_TUTORIAL_RESET,               "CMSG_TUTORIAL_RESET",              STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleTutorialResetOpcode);
-    /*0x101*/  StoreOpcode(CMSG_STANDSTATECHANGE,             "CMSG_STANDSTATECHANGE",            STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleStandStateChangeOpcode);
+    /*0x101*/  StoreOpcode(CMSG_STANDSTATECHANGE,             "CMSG_STANDSTATECHANGE",            STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleStandStateChangeOpcode);
     /*0x102*/  StoreOpcode(CMSG_EMOTE,                        "CMSG_EMOTE",                       STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleEmoteOpcode);
     /*0x103*/  StoreOpcode(SMSG_EMOTE,                        "SMSG_EMOTE",                       STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x104*/  StoreOpcode(CMSG_TEXT_EMOTE,                   "CMSG_TEXT_EMOTE",                  STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleTextEmoteOpcode);
@@ -352,27 +430,27 @@ void OpcodeStore::BuildOpcodeList()
     /*0x12B*/  StoreOpcode(SMSG_LEARNED_SPELL,                "SMSG_LEARNED_SPELL",               STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x12C*/  StoreOpcode(SMSG_SUPERCEDED_SPELL,             "SMSG_SUPERCEDED_SPELL",            STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x12D*/  StoreOpcode(CMSG_NEW_SPELL_SLOT,               "CMSG_NEW_SPELL_SLOT",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
-    /*0x12E*/  StoreOpcode(CMSG_CAST_SPELL,                   "CMSG_CAST_SPELL",                  STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleCastSpellOpcode);
-    /*0x12F*/  StoreOpcode(CMSG_CANCEL_CAST,                  "CMSG_CANCEL_CAST",                 STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleCancelCastOpcode);
+    /*0x12E*/  StoreOpcode(CMSG_CAST_SPELL,                   "CMSG_CAST_SPELL",                  STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleCastSpellOpcode);
+    /*0x12F*/  StoreOpcode(CMSG_CANCEL_CAST,                  "CMSG_CANCEL_CAST",                 STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleCancelCastOpcode);
     /*0x130*/  StoreOpcode(SMSG_CAST_RESULT,                  "SMSG_CAST_RESULT",                 STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x131*/  StoreOpcode(SMSG_SPELL_START,                  "SMSG_SPELL_START",                 STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x132*/  StoreOpcode(SMSG_SPELL_GO,                     "SMSG_SPELL_GO",                    STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x133*/  StoreOpcode(SMSG_SPELL_FAILURE,                "SMSG_SPELL_FAILURE",               STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x134*/  StoreOpcode(SMSG_SPELL_COOLDOWN,               "SMSG_SPELL_COOLDOWN",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x135*/  StoreOpcode(SMSG_COOLDOWN_EVENT,               "SMSG_COOLDOWN_EVENT",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x136*/  StoreOpcode(CMSG_CANCEL_AURA,                  "CMSG_CANCEL_AURA",                 STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleCancelAuraOpcode);
+    /*0x136*/  StoreOpcode(CMSG_CANCEL_AURA,                  "CMSG_CANCEL_AURA",                 STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleCancelAuraOpcode);
     /*0x137*/  StoreOpcode(SMSG_UPDATE_AURA_DURATION,         "SMSG_UPDATE_AURA_DURATION",        STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x138*/  StoreOpcode(SMSG_PET_CAST_FAILED,              "SMSG_PET_CAST_FAILED",             STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x139*/  StoreOpcode(MSG_CHANNEL_START,                 "MSG_CHANNEL_START",                STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x13A*/  StoreOpcode(MSG_CHANNEL_UPDATE,                "MSG_CHANNEL_UPDATE",               STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
-    /*0x13B*/  StoreOpcode(CMSG_CANCEL_CHANNELLING,           "CMSG_CANCEL_CHANNELLING",          STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleCancelChanneling);
+    /*0x13B*/  StoreOpcode(CMSG_CANCEL_CHANNELLING,           "CMSG_CANCEL_CHANNELLING",          STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleCancelChanneling);
     /*0x13C*/  StoreOpcode(SMSG_AI_REACTION,                  "SMSG_AI_REACTION",                 STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x13D*/  StoreOpcode(CMSG_SET_SELECTION,                "CMSG_SET_SELECTION",               STATUS_LOGGEDIN,  PROCESS_INPLACE,      &WorldSession::HandleSetSelectionOpcode);
     /*0x13E*/  StoreOpcode(CMSG_SET_TARGET_OBSOLETE,          "CMSG_SET_TARGET_OBSOLETE",         STATUS_LOGGEDIN,  PROCESS_INPLACE,      &WorldSession::HandleSetTargetOpcode);
     /*0x13F*/  StoreOpcode(CMSG_UNUSED,                       "CMSG_UNUSED",                      STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x140*/  StoreOpcode(CMSG_UNUSED2,                      "CMSG_UNUSED2",                     STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
-    /*0x141*/  StoreOpcode(CMSG_ATTACKSWING,                  "CMSG_ATTACKSWING",                 STATUS_LOGGEDIN,  PROCESS_INPLACE,      &WorldSession::HandleAttackSwingOpcode);
-    /*0x142*/  StoreOpcode(CMSG_ATTACKSTOP,                   "CMSG_ATTACKSTOP",                  STATUS_LOGGEDIN,  PROCESS_INPLACE,      &WorldSession::HandleAttackStopOpcode);
+    /*0x141*/  StoreOpcode(CMSG_ATTACKSWING,                  "CMSG_ATTACKSWING",                 STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleAttackSwingOpcode);
+    /*0x142*/  StoreOpcode(CMSG_ATTACKSTOP,                   "CMSG_ATTACKSTOP",                  STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleAttackStopOpcode);
     /*0x143*/  StoreOpcode(SMSG_ATTACKSTART,                  "SMSG_ATTACKSTART",                 STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x144*/  StoreOpcode(SMSG_ATTACKSTOP,                   "SMSG_ATTACKSTOP",                  STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x145*/  StoreOpcode(SMSG_ATTACKSWING_NOTINRANGE,       "SMSG_ATTACKSWING_NOTINRANGE",      STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -423,7 +501,7 @@ void OpcodeStore::BuildOpcodeList()
     /*0x172*/  StoreOpcode(SMSG_MOUNTSPECIAL_ANIM,            "SMSG_MOUNTSPECIAL_ANIM",           STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x173*/  StoreOpcode(SMSG_PET_TAME_FAILURE,             "SMSG_PET_TAME_FAILURE",            STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x174*/  StoreOpcode(CMSG_PET_SET_ACTION,               "CMSG_PET_SET_ACTION",              STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePetSetAction);
-    /*0x175*/  StoreOpcode(CMSG_PET_ACTION,                   "CMSG_PET_ACTION",                  STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePetAction);
+    /*0x175*/  StoreOpcode(CMSG_PET_ACTION,                   "CMSG_PET_ACTION",                  STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandlePetAction);
     /*0x176*/  StoreOpcode(CMSG_PET_ABANDON,                  "CMSG_PET_ABANDON",                 STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePetAbandon);
     /*0x177*/  StoreOpcode(CMSG_PET_RENAME,                   "CMSG_PET_RENAME",                  STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePetRename);
     /*0x178*/  StoreOpcode(SMSG_PET_NAME_INVALID,             "SMSG_PET_NAME_INVALID",            STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -530,7 +608,7 @@ void OpcodeStore::BuildOpcodeList()
     /*0x1DD*/  StoreOpcode(SMSG_PONG,                         "SMSG_PONG",                        STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x1DE*/  StoreOpcode(SMSG_CLEAR_COOLDOWN,               "SMSG_CLEAR_COOLDOWN",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x1DF*/  StoreOpcode(SMSG_GAMEOBJECT_PAGETEXT,          "SMSG_GAMEOBJECT_PAGETEXT",         STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x1E0*/  StoreOpcode(CMSG_SETSHEATHED,                  "CMSG_SETSHEATHED",                 STATUS_LOGGEDIN,  PROCESS_INPLACE,      &WorldSession::HandleSetSheathedOpcode);
+    /*0x1E0*/  StoreOpcode(CMSG_SETSHEATHED,                  "CMSG_SETSHEATHED",                 STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleSetSheathedOpcode);
     /*0x1E1*/  StoreOpcode(SMSG_COOLDOWN_CHEAT,               "SMSG_COOLDOWN_CHEAT",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x1E2*/  StoreOpcode(SMSG_SPELL_DELAYED,                "SMSG_SPELL_DELAYED",               STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x1E3*/  StoreOpcode(CMSG_PLAYER_MACRO_OBSOLETE,        "CMSG_PLAYER_MACRO_OBSOLETE",       STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
@@ -546,7 +624,7 @@ void OpcodeStore::BuildOpcodeList()
     /*0x1ED*/  StoreOpcode(CMSG_AUTH_SESSION,                 "CMSG_AUTH_SESSION",                STATUS_NEVER,     PROCESS_THREADSAFE,   &WorldSession::Handle_EarlyProccess);
     /*0x1EE*/  StoreOpcode(SMSG_AUTH_RESPONSE,                "SMSG_AUTH_RESPONSE",               STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x1EF*/  StoreOpcode(MSG_GM_SHOWLABEL,                  "MSG_GM_SHOWLABEL",                 STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
-    /*0x1F0*/  StoreOpcode(CMSG_PET_CAST_SPELL,               "CMSG_PET_CAST_SPELL",              STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePetCastSpellOpcode);
+    /*0x1F0*/  StoreOpcode(CMSG_PET_CAST_SPELL,               "CMSG_PET_CAST_SPELL",              STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandlePetCastSpellOpcode);
     /*0x1F1*/  StoreOpcode(MSG_SAVE_GUILD_EMBLEM,             "MSG_SAVE_GUILD_EMBLEM",            STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleSaveGuildEmblemOpcode);
     /*0x1F2*/  StoreOpcode(MSG_TABARDVENDOR_ACTIVATE,         "MSG_TABARDVENDOR_ACTIVATE",        STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleTabardVendorActivateOpcode);
     /*0x1F3*/  StoreOpcode(SMSG_PLAY_SPELL_VISUAL,            "SMSG_PLAY_SPELL_VISUAL",           STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -666,10 +744,10 @@ void OpcodeStore::BuildOpcodeList()
     /*0x267*/  StoreOpcode(SMSG_SET_PCT_SPELL_MODIFIER,       "SMSG_SET_PCT_SPELL_MODIFIER",      STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x268*/  StoreOpcode(CMSG_SET_AMMO,                     "CMSG_SET_AMMO",                    STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleSetAmmoOpcode);
     /*0x269*/  StoreOpcode(SMSG_CORPSE_RECLAIM_DELAY,         "SMSG_CORPSE_RECLAIM_DELAY",        STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x26A*/  StoreOpcode(CMSG_SET_ACTIVE_MOVER,             "CMSG_SET_ACTIVE_MOVER",            STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleSetActiveMoverOpcode);
+    /*0x26A*/  StoreOpcode(CMSG_SET_ACTIVE_MOVER,             "CMSG_SET_ACTIVE_MOVER",            STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleSetActiveMoverOpcode);
     /*0x26B*/  StoreOpcode(CMSG_PET_CANCEL_AURA,              "CMSG_PET_CANCEL_AURA",             STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePetCancelAuraOpcode);
     /*0x26C*/  StoreOpcode(CMSG_PLAYER_AI_CHEAT,              "CMSG_PLAYER_AI_CHEAT",             STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
-    /*0x26D*/  StoreOpcode(CMSG_CANCEL_AUTO_REPEAT_SPELL,     "CMSG_CANCEL_AUTO_REPEAT_SPELL",    STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleCancelAutoRepeatSpellOpcode);
+    /*0x26D*/  StoreOpcode(CMSG_CANCEL_AUTO_REPEAT_SPELL,     "CMSG_CANCEL_AUTO_REPEAT_SPELL",    STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleCancelAutoRepeatSpellOpcode);
     /*0x26E*/  StoreOpcode(MSG_GM_ACCOUNT_ONLINE,             "MSG_GM_ACCOUNT_ONLINE",            STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x26F*/  StoreOpcode(MSG_LIST_STABLED_PETS,             "MSG_LIST_STABLED_PETS",            STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleListStabledPetsOpcode);
     /*0x270*/  StoreOpcode(CMSG_STABLE_PET,                   "CMSG_STABLE_PET",                  STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleStablePet);
@@ -761,15 +839,15 @@ void OpcodeStore::BuildOpcodeList()
     /*0x2C6*/  StoreOpcode(SMSG_PET_ACTION_FEEDBACK,          "SMSG_PET_ACTION_FEEDBACK",         STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2C7*/  StoreOpcode(CMSG_CHAR_RENAME,                  "CMSG_CHAR_RENAME",                 STATUS_AUTHED,    PROCESS_THREADUNSAFE, &WorldSession::HandleCharRenameOpcode);
     /*0x2C8*/  StoreOpcode(SMSG_CHAR_RENAME,                  "SMSG_CHAR_RENAME",                 STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x2C9*/  StoreOpcode(CMSG_MOVE_SPLINE_DONE,             "CMSG_MOVE_SPLINE_DONE",            STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMoveSplineDoneOpcode);
-    /*0x2CA*/  StoreOpcode(CMSG_MOVE_FALL_RESET,              "CMSG_MOVE_FALL_RESET",             STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
+    /*0x2C9*/  StoreOpcode(CMSG_MOVE_SPLINE_DONE,             "CMSG_MOVE_SPLINE_DONE",            STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMoveSplineDoneOpcode);
+    /*0x2CA*/  StoreOpcode(CMSG_MOVE_FALL_RESET,              "CMSG_MOVE_FALL_RESET",             STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
     /*0x2CB*/  StoreOpcode(SMSG_INSTANCE_SAVE_CREATED,        "SMSG_INSTANCE_SAVE_CREATED",       STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2CC*/  StoreOpcode(SMSG_RAID_INSTANCE_INFO,           "SMSG_RAID_INSTANCE_INFO",          STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2CD*/  StoreOpcode(CMSG_REQUEST_RAID_INFO,            "CMSG_REQUEST_RAID_INFO",           STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleRequestRaidInfoOpcode);
-    /*0x2CE*/  StoreOpcode(CMSG_MOVE_TIME_SKIPPED,            "CMSG_MOVE_TIME_SKIPPED",           STATUS_LOGGEDIN,  PROCESS_INPLACE,      &WorldSession::HandleMoveTimeSkippedOpcode);
-    /*0x2CF*/  StoreOpcode(CMSG_MOVE_FEATHER_FALL_ACK,        "CMSG_MOVE_FEATHER_FALL_ACK",       STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMoveFlagChangeOpcode);
-    /*0x2D0*/  StoreOpcode(CMSG_MOVE_WATER_WALK_ACK,          "CMSG_MOVE_WATER_WALK_ACK",         STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMoveFlagChangeOpcode);
-    /*0x2D1*/  StoreOpcode(CMSG_MOVE_NOT_ACTIVE_MOVER,        "CMSG_MOVE_NOT_ACTIVE_MOVER",       STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMoveNotActiveMoverOpcode);
+    /*0x2CE*/  StoreOpcode(CMSG_MOVE_TIME_SKIPPED,            "CMSG_MOVE_TIME_SKIPPED",           STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMoveTimeSkippedOpcode);
+    /*0x2CF*/  StoreOpcode(CMSG_MOVE_FEATHER_FALL_ACK,        "CMSG_MOVE_FEATHER_FALL_ACK",       STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMoveFlagChangeOpcode);
+    /*0x2D0*/  StoreOpcode(CMSG_MOVE_WATER_WALK_ACK,          "CMSG_MOVE_WATER_WALK_ACK",         STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMoveFlagChangeOpcode);
+    /*0x2D1*/  StoreOpcode(CMSG_MOVE_NOT_ACTIVE_MOVER,        "CMSG_MOVE_NOT_ACTIVE_MOVER",       STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMoveNotActiveMoverOpcode);
     /*0x2D2*/  StoreOpcode(SMSG_PLAY_SOUND,                   "SMSG_PLAY_SOUND",                  STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2D3*/  StoreOpcode(CMSG_BATTLEFIELD_STATUS,           "CMSG_BATTLEFIELD_STATUS",          STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleBattlefieldStatusOpcode);
     /*0x2D4*/  StoreOpcode(SMSG_BATTLEFIELD_STATUS,           "SMSG_BATTLEFIELD_STATUS",          STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -779,11 +857,11 @@ void OpcodeStore::BuildOpcodeList()
     /*0x2D8*/  StoreOpcode(CMSG_MOVE_START_SWIM_CHEAT,        "CMSG_MOVE_START_SWIM_CHEAT",       STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x2D9*/  StoreOpcode(CMSG_MOVE_STOP_SWIM_CHEAT,         "CMSG_MOVE_STOP_SWIM_CHEAT",        STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_NULL);
     /*0x2DA*/  StoreOpcode(SMSG_FORCE_WALK_SPEED_CHANGE,      "SMSG_FORCE_WALK_SPEED_CHANGE",     STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x2DB*/  StoreOpcode(CMSG_FORCE_WALK_SPEED_CHANGE_ACK,  "CMSG_FORCE_WALK_SPEED_CHANGE_ACK", STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleForceSpeedChangeAckOpcodes);
+    /*0x2DB*/  StoreOpcode(CMSG_FORCE_WALK_SPEED_CHANGE_ACK,  "CMSG_FORCE_WALK_SPEED_CHANGE_ACK", STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleForceSpeedChangeAckOpcodes);
     /*0x2DC*/  StoreOpcode(SMSG_FORCE_SWIM_BACK_SPEED_CHANGE, "SMSG_FORCE_SWIM_BACK_SPEED_CHANGE", STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x2DD*/  StoreOpcode(CMSG_FORCE_SWIM_BACK_SPEED_CHANGE_ACK,  "CMSG_FORCE_SWIM_BACK_SPEED_CHANGE_ACK",   STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleForceSpeedChangeAckOpcodes);
+    /*0x2DD*/  StoreOpcode(CMSG_FORCE_SWIM_BACK_SPEED_CHANGE_ACK,  "CMSG_FORCE_SWIM_BACK_SPEED_CHANGE_ACK",   STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleForceSpeedChangeAckOpcodes);
     /*0x2DE*/  StoreOpcode(SMSG_FORCE_TURN_RATE_CHANGE,       "SMSG_FORCE_TURN_RATE_CHANGE",      STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x2DF*/  StoreOpcode(CMSG_FORCE_TURN_RATE_CHANGE_ACK,   "CMSG_FORCE_TURN_RATE_CHANGE_ACK",  STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleForceSpeedChangeAckOpcodes);
+    /*0x2DF*/  StoreOpcode(CMSG_FORCE_TURN_RATE_CHANGE_ACK,   "CMSG_FORCE_TURN_RATE_CHANGE_ACK",  STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleForceSpeedChangeAckOpcodes);
     /*0x2E0*/  StoreOpcode(MSG_PVP_LOG_DATA,                  "MSG_PVP_LOG_DATA",                 STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePVPLogDataOpcode);
     /*0x2E1*/  StoreOpcode(CMSG_LEAVE_BATTLEFIELD,            "CMSG_LEAVE_BATTLEFIELD",           STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleLeaveBattlefieldOpcode);
     /*0x2E2*/  StoreOpcode(CMSG_AREA_SPIRIT_HEALER_QUERY,     "CMSG_AREA_SPIRIT_HEALER_QUERY",    STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleAreaSpiritHealerQueryOpcode);
@@ -794,7 +872,7 @@ void OpcodeStore::BuildOpcodeList()
     /*0x2E7*/  StoreOpcode(CMSG_WARDEN_DATA,                  "CMSG_WARDEN_DATA",                 STATUS_AUTHED,    PROCESS_THREADUNSAFE, &WorldSession::HandleWardenDataOpcode);
     /*0x2E8*/  StoreOpcode(SMSG_GROUP_JOINED_BATTLEGROUND,    "SMSG_GROUP_JOINED_BATTLEGROUND",   STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2E9*/  StoreOpcode(MSG_BATTLEGROUND_PLAYER_POSITIONS, "MSG_BATTLEGROUND_PLAYER_POSITIONS", STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleBattleGroundPlayerPositionsOpcode);
-    /*0x2EA*/  StoreOpcode(CMSG_PET_STOP_ATTACK,              "CMSG_PET_STOP_ATTACK",             STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePetStopAttack);
+    /*0x2EA*/  StoreOpcode(CMSG_PET_STOP_ATTACK,              "CMSG_PET_STOP_ATTACK",             STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandlePetStopAttack);
     /*0x2EB*/  StoreOpcode(SMSG_BINDER_CONFIRM,               "SMSG_BINDER_CONFIRM",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2EC*/  StoreOpcode(SMSG_BATTLEGROUND_PLAYER_JOINED,   "SMSG_BATTLEGROUND_PLAYER_JOINED",  STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2ED*/  StoreOpcode(SMSG_BATTLEGROUND_PLAYER_LEFT,     "SMSG_BATTLEGROUND_PLAYER_LEFT",    STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -803,7 +881,7 @@ void OpcodeStore::BuildOpcodeList()
     /*0x2F0*/  StoreOpcode(CMSG_PET_UNLEARN,                  "CMSG_PET_UNLEARN",                 STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePetUnlearnOpcode);
     /*0x2F1*/  StoreOpcode(SMSG_PET_UNLEARN_CONFIRM,          "SMSG_PET_UNLEARN_CONFIRM",         STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2F2*/  StoreOpcode(SMSG_PARTY_MEMBER_STATS_FULL,      "SMSG_PARTY_MEMBER_STATS_FULL",     STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
-    /*0x2F3*/  StoreOpcode(CMSG_PET_SPELL_AUTOCAST,           "CMSG_PET_SPELL_AUTOCAST",          STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePetSpellAutocastOpcode);
+    /*0x2F3*/  StoreOpcode(CMSG_PET_SPELL_AUTOCAST,           "CMSG_PET_SPELL_AUTOCAST",          STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandlePetSpellAutocastOpcode);
     /*0x2F4*/  StoreOpcode(SMSG_WEATHER,                      "SMSG_WEATHER",                     STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2F5*/  StoreOpcode(SMSG_PLAY_TIME_WARNING,            "SMSG_PLAY_TIME_WARNING",           STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x2F6*/  StoreOpcode(SMSG_MINIGAME_SETUP,               "SMSG_MINIGAME_SETUP",              STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
@@ -885,7 +963,7 @@ void OpcodeStore::BuildOpcodeList()
     /*0x375*/  StoreOpcode(CMSG_CANCEL_MOUNT_AURA,            "CMSG_CANCEL_MOUNT_AURA",           STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleCancelMountAuraOpcode);
     /*0x379*/  StoreOpcode(CMSG_CANCEL_TEMP_ENCHANTMENT,      "CMSG_CANCEL_TEMP_ENCHANTMENT",     STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandleCancelTempEnchantmentOpcode);
     /*0x389*/  StoreOpcode(CMSG_SET_TAXI_BENCHMARK_MODE,      "CMSG_SET_TAXI_BENCHMARK_MODE",     STATUS_AUTHED,    PROCESS_THREADUNSAFE, &WorldSession::HandleSetTaxiBenchmarkOpcode);
-    /*0x38D*/  StoreOpcode(CMSG_MOVE_CHNG_TRANSPORT,          "CMSG_MOVE_CHNG_TRANSPORT",         STATUS_LOGGEDIN,  PROCESS_THREADSAFE,   &WorldSession::HandleMovementOpcodes);
+    /*0x38D*/  StoreOpcode(CMSG_MOVE_CHNG_TRANSPORT,          "CMSG_MOVE_CHNG_TRANSPORT",         STATUS_LOGGEDIN,  PROCESS_MAP_THREAD,   &WorldSession::HandleMovementOpcodes);
     /*0x38E*/  StoreOpcode(MSG_PARTY_ASSIGNMENT,              "MSG_PARTY_ASSIGNMENT",             STATUS_LOGGEDIN,  PROCESS_THREADUNSAFE, &WorldSession::HandlePartyAssignmentOpcode);
     /*0x38F*/  StoreOpcode(SMSG_OFFER_PETITION_ERROR,         "SMSG_OFFER_PETITION_ERROR",        STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
     /*0x396*/  StoreOpcode(SMSG_RESET_FAILED_NOTIFY,          "SMSG_RESET_FAILED_NOTIFY",         STATUS_NEVER,     PROCESS_INPLACE,      &WorldSession::Handle_ServerSide);
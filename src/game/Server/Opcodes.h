@@ -25,6 +25,9 @@
 
 #include "Common.h"
 
+#include <atomic>
+#include <vector>
+
 // Note: this include need for be sure have full definition of class WorldSession
 //       if this class definition not complite then VS for x64 release use different size for
 //       struct OpcodeHandler in this header and Opcode.cpp and get totally wrong data from
@@ -963,7 +966,7 @@ enum PacketProcessing
     PROCESS_INPLACE = 0,                                    // process packet whenever we receive it - mostly for non-handled or non-implemented packets
     PROCESS_THREADUNSAFE,                                   // packet is not thread-safe - process it in World::UpdateSessions()
     PROCESS_THREADSAFE,                                     // packet is thread-safe - process it in Map::Update()
-    PROCESS_MAP_THREAD,                                     // packet is map thread safe
+    PROCESS_MAP_THREAD,                                     // packet only touches the player, its pet and its map - process it in WorldSession::UpdateMap() from Map::Update()
     PROCESS_IMMEDIATE,                                      // packet is network thread safe
 };
 
@@ -977,7 +980,26 @@ struct OpcodeHandler
     void (WorldSession::*handler)(WorldPacket& recvPacket);
 };
 
-typedef std::map< uint16, OpcodeHandler> OpcodeMap;
+#define OPCODE_TIME_BUCKETS 24                              // bucket i counts handler times below 2^i us, the last one everything above
+
+/// Received packets of one opcode, counted while Network.OpcodeStats is enabled
+struct OpcodeStatistics
+{
+    std::atomic<uint64> count;
+    std::atomic<uint64> bytes;
+    std::atomic<uint64> timeUs;
+    std::atomic<uint32> timeBuckets[OPCODE_TIME_BUCKETS];
+};
+
+struct OpcodeStatisticsSummary
+{
+    uint16 opcode;
+    uint64 count;
+    uint64 bytes;
+    uint64 timeUs;
+    uint32 p50Us;                                           // upper bound of the bucket holding the median
+    uint32 p99Us;
+};
 
 class OpcodeStore
 {
@@ -988,7 +1010,8 @@ class OpcodeStore
         void BuildOpcodeList();
         void StoreOpcode(uint16 Opcode, char const* name, SessionStatus status, PacketProcessing process, void (WorldSession::*handler)(WorldPacket& recvPacket))
         {
-            OpcodeHandler& ref = mOpcodeMap[Opcode];
+            MANGOS_ASSERT(Opcode < NUM_MSG_TYPES);
+            OpcodeHandler& ref = m_opcodes[Opcode];
             ref.name = name;
             ref.status = status;
             ref.packetProcessing = process;
@@ -998,9 +1021,8 @@ class OpcodeStore
         /// Lookup opcode
         inline OpcodeHandler const* LookupOpcode(uint16 id) const
         {
-            OpcodeMap::const_iterator itr = mOpcodeMap.find(id);
-            if (itr != mOpcodeMap.end())
-                return &itr->second;
+            if (id < NUM_MSG_TYPES && m_opcodes[id].name)
+                return &m_opcodes[id];
             return nullptr;
         }
 
@@ -1008,15 +1030,25 @@ class OpcodeStore
 
         inline OpcodeHandler const& operator[](uint16 id) const
         {
-            OpcodeMap::const_iterator itr = mOpcodeMap.find(id);
-            if (itr != mOpcodeMap.end())
-                return itr->second;
+            if (id < NUM_MSG_TYPES && m_opcodes[id].name)
+                return m_opcodes[id];
             return emptyHandler;
         }
 
         static OpcodeHandler const emptyHandler;
 
-        OpcodeMap mOpcodeMap;
+        // per opcode statistics, recorded from the world and the map threads
+        void SetStatisticsEnabled(bool enabled) { m_statisticsEnabled = enabled; }
+        bool IsStatisticsEnabled() const { return m_statisticsEnabled; }
+        void RecordPacket(uint16 opcode, size_t bytes, uint32 timeUs);
+        void ResetStatistics();
+        // opcodes received since the last reset
+        std::vector<OpcodeStatisticsSummary> GetStatistics() const;
+
+    private:
+        OpcodeHandler m_opcodes[NUM_MSG_TYPES];             // indexed by opcode, name is nullptr for opcodes never stored
+        OpcodeStatistics m_statistics[NUM_MSG_TYPES];
+        std::atomic<bool> m_statisticsEnabled;
 };
 
 #define opcodeTable MaNGOS::Singleton<OpcodeStore>::Instance()
@@ -42,6 +42,10 @@
 #include "Anticheat/Anticheat.hpp"
 #include "AI/ScriptDevAI/scripts/custom/Transmogrification.h"
 
+#ifdef BUILD_METRICS
+#include "Metric/Metric.h"
+#endif
+
 #include <mutex>
 #include <deque>
 #include <memory>
@@ -169,7 +173,7 @@ void WorldSession::SetInCharSelection()
 
 bool WorldSession::RequestNewSocket(WorldSocket* socket)
 {
-    std::lock_guard<std::mutex> guard(m_recvQueueLock);
+    std::lock_guard<std::mutex> guard(m_requestSocketLock);
     if (m_requestSocket)
         return false;
 
@@ -198,9 +202,43 @@ void WorldSession::SetPlayer(Player* plr, uint32 playerGuid)
     m_anticheat->NewPlayer();
 }
 
+/// Whether anybody reads this opcode, bots read anything but object updates
+bool WorldSession::IsOpcodeWanted(uint16 opcode) const
+{
+    // real client gets everything
+    if (m_Socket)
+        return true;
+
+#ifdef BUILD_PLAYERBOT
+    // bot AI ignores what it has no case for in HandleBotOutgoingPacket
+    if (_player && _player->GetPlayerbotAI())
+        return opcode != SMSG_UPDATE_OBJECT && opcode != SMSG_COMPRESSED_UPDATE_OBJECT;
+#endif
+
+#ifdef ENABLE_PLAYERBOTS
+    // bot module handles any packet except object updates
+    if (_player && _player->GetPlayerbotAI())
+        return opcode != SMSG_UPDATE_OBJECT && opcode != SMSG_COMPRESSED_UPDATE_OBJECT;
+#endif
+
+    return false;
+}
+
+bool WorldSession::WantsObjectUpdates() const
+{
+    return IsOpcodeWanted(SMSG_UPDATE_OBJECT) || IsOpcodeWanted(SMSG_COMPRESSED_UPDATE_OBJECT);
+}
+
 /// Send a packet to the client
 void WorldSession::SendPacket(WorldPacket const& packet, bool forcedSend /*= false*/) const
 {
+    // Nobody to read it
+    if (!IsOpcodeWanted(packet.GetOpcode()))
+    {
+        sWorld.AddDroppedPacket(packet.size());
+        return;
+    }
+
 #ifdef BUILD_PLAYERBOT
     // Send packet to bot AI
     if (GetPlayer())
@@ -273,6 +311,11 @@ void WorldSession::QueuePacket(std::unique_ptr<WorldPacket> new_packet)
     OpcodeHandler const& opHandle = opcodeTable[new_packet->GetOpcode()];
     if (opHandle.packetProcessing == PROCESS_IMMEDIATE)
     {
+        bool const recordStatistics = opcodeTable.IsStatisticsEnabled();
+        std::chrono::steady_clock::time_point handlerStart;
+        if (recordStatistics)
+            handlerStart = std::chrono::steady_clock::now();
+
         try
         {
             (this->*opHandle.handler)(*new_packet);
@@ -282,34 +325,34 @@ void WorldSession::QueuePacket(std::unique_ptr<WorldPacket> new_packet)
             ProcessByteBufferException(*new_packet);
         }
 
+        if (recordStatistics)
+            opcodeTable.RecordPacket(new_packet->GetOpcode(), new_packet->size(),
+                uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - handlerStart).count()));
+
         if (new_packet->rpos() < new_packet->wpos() && sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG))
             LogUnprocessedTail(*new_packet);
         return;
     }
 
-    if (opHandle.packetProcessing == PROCESS_MAP_THREAD)
-    {
-        std::lock_guard<std::mutex> guard(m_recvQueueMapLock);
-        m_recvQueueMap.push_back(std::move(new_packet));
-    }
+    // sessions without socket (bots) are never updated by the map, their packets stay on the world queue
+    if (opHandle.packetProcessing == PROCESS_MAP_THREAD && m_Socket)
+        m_recvQueueMap.Push(std::move(new_packet));
     else
-    {
-        std::lock_guard<std::mutex> guard(m_recvQueueLock);
-        m_recvQueue.push_back(std::move(new_packet));
-    }
+        m_recvQueue.Push(std::move(new_packet));
 }
 
 void WorldSession::DeleteMovementPackets()
 {
-    std::lock_guard<std::mutex> guard(m_recvQueueMapLock);
-    for (auto itr = m_recvQueueMap.begin(); itr != m_recvQueueMap.end();)
+    // called where the map packets are processed, so we are their only consumer
+    m_recvQueueMap.Drain([this](std::unique_ptr<WorldPacket>& packet) { m_recvQueueMapPending.push_back(std::move(packet)); });
+    for (auto itr = m_recvQueueMapPending.begin(); itr != m_recvQueueMapPending.end();)
     {
         switch ((*itr)->GetOpcode())
         {
             case MSG_MOVE_SET_FACING:
             case MSG_MOVE_HEARTBEAT:
             {
-                itr = m_recvQueueMap.erase(itr);
+                itr = m_recvQueueMapPending.erase(itr);
                 break;
             }
             default:
@@ -319,6 +362,14 @@ void WorldSession::DeleteMovementPackets()
     }
 }
 
+void WorldSession::ClearMapPackets()
+{
+    // only the consumer of the map queue may call this: a handler run by UpdateMap, which works on its own copy
+    // of the pending packets, or the world thread while no map is updated
+    m_recvQueueMap.Clear();
+    m_recvQueueMapPending.clear();
+}
+
 /// Logging helper for unexpected opcodes
 void WorldSession::LogUnexpectedOpcode(WorldPacket const& packet, const char* reason) const
 {
@@ -366,10 +417,7 @@ bool WorldSession::Update(uint32 diff)
     GetMessager().Execute(this);
 
     std::deque<std::unique_ptr<WorldPacket>> recvQueueCopy;
-    {
-        std::lock_guard<std::mutex> guard(m_recvQueueLock);
-        std::swap(recvQueueCopy, m_recvQueue);
-    }
+    m_recvQueue.Drain([&recvQueueCopy](std::unique_ptr<WorldPacket>& packet) { recvQueueCopy.push_back(std::move(packet)); });
 
     if (m_Socket && !m_Socket->IsClosed() && m_anticheat)
     {
@@ -473,14 +521,11 @@ bool WorldSession::Update(uint32 diff)
         {
             Player* const botPlayer = itr->second;
             WorldSession* const pBotWorldSession = botPlayer->GetSession();
-            while(!pBotWorldSession->m_recvQueue.empty())
+            pBotWorldSession->m_recvQueue.Drain([pBotWorldSession](std::unique_ptr<WorldPacket>& botpacket)
             {
-                auto const botpacket = std::move(pBotWorldSession->m_recvQueue.front());
-                pBotWorldSession->m_recvQueue.pop_front();
-
                 OpcodeHandler const& opHandle = opcodeTable[botpacket->GetOpcode()];
                 pBotWorldSession->ExecuteOpcode(opHandle, *botpacket);
-            }
+            });
         }
         GetPlayer()->GetPlayerbotMgr()->RemoveBots();
     }
@@ -575,14 +620,17 @@ bool WorldSession::Update(uint32 diff)
 
 void WorldSession::UpdateMap(uint32 diff)
 {
+    m_recvQueueMap.Drain([this](std::unique_ptr<WorldPacket>& packet) { m_recvQueueMapPending.push_back(std::move(packet)); });
+
     std::deque<std::unique_ptr<WorldPacket>> recvQueueMapCopy;
-    {
-        std::lock_guard<std::mutex> guard(m_recvQueueMapLock);
-        std::swap(recvQueueMapCopy, m_recvQueueMap);
-    }
+    std::swap(recvQueueMapCopy, m_recvQueueMapPending);
 
     while (m_Socket && !m_Socket->IsClosed() && recvQueueMapCopy.size())
     {
+        // a handler started a far teleport, the rest was sent for the map the player is leaving
+        if (_player && _player->IsBeingTeleportedFar())
+            break;
+
         auto const packet = std::move(recvQueueMapCopy.front());
         recvQueueMapCopy.pop_front();
 
@@ -590,7 +638,7 @@ void WorldSession::UpdateMap(uint32 diff)
         
         if (opHandle.status == STATUS_LOGGEDIN)
         {
-            ExecuteOpcode(opHandle, *packet);
+            ExecuteOpcode(opHandle, *packet, true);
         }
     }
 }
@@ -598,13 +646,11 @@ void WorldSession::UpdateMap(uint32 diff)
 #ifdef ENABLE_PLAYERBOTS
 void WorldSession::HandleBotPackets()
 {
-    while (!m_recvQueue.empty())
+    m_recvQueue.Drain([this](std::unique_ptr<WorldPacket>& packet)
     {
-        auto const packet = std::move(m_recvQueue.front());
-        m_recvQueue.pop_front();
         OpcodeHandler const& opHandle = opcodeTable[packet->GetOpcode()];
         (this->*opHandle.handler)(*packet);
-    }
+    });
 }
 #endif
 
@@ -838,6 +884,9 @@ void WorldSession::LogoutPlayer()
     m_playerLogout = false;
     m_playerRecentlyLogout = true;
 
+    // map packets of the old character must not reach the next one
+    ClearMapPackets();
+
     SetInCharSelection();
 
     _logoutTime = 0;
@@ -1226,8 +1275,14 @@ void WorldSession::SendTransferAborted(uint32 mapid, uint8 reason, uint8 arg) co
     SendPacket(data);
 }
 
-void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& packet)
+void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& packet, bool inMapThread /*= false*/)
 {
+#ifdef BUILD_METRICS
+    metric::duration<std::chrono::microseconds> meas("session.opcode", {
+        { "opcode", opHandle.name },
+        { "thread", inMapThread ? "map" : "world" }
+    });
+#endif
 #ifdef BUILD_ELUNA
     if (!sEluna->OnPacketReceive(this, packet))
     {
@@ -1239,6 +1294,11 @@ void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& pac
     if (_player)
         _player->SetCanDelayTeleport(true);
 
+    bool const recordStatistics = opcodeTable.IsStatisticsEnabled();
+    std::chrono::steady_clock::time_point handlerStart;
+    if (recordStatistics)
+        handlerStart = std::chrono::steady_clock::now();
+
     try
     {
         (this->*opHandle.handler)(packet);
@@ -1248,6 +1308,10 @@ void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& pac
         ProcessByteBufferException(packet);
     }
 
+    if (recordStatistics)
+        opcodeTable.RecordPacket(packet.GetOpcode(), packet.size(),
+            uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - handlerStart).count()));
+
     if (_player)
     {
         // can be not set in fact for login opcode, but this not create porblems.
@@ -31,6 +31,7 @@
 #include "Entities/Item.h"
 #include "Server/WorldSocket.h"
 #include "Multithreading/Messager.h"
+#include "Multithreading/MPSCQueue.h"
 
 #include <deque>
 #include <mutex>
@@ -212,6 +213,9 @@ class WorldSession
         void SizeError(WorldPacket const& packet, uint32 size) const;
 
         void SendPacket(WorldPacket const& packet, bool forcedSend = false) const;
+        // Sessions without socket (bots, disconnected players) only want packets consumed by their AI
+        bool IsOpcodeWanted(uint16 opcode) const;
+        bool WantsObjectUpdates() const;
         void SendExpectedSpamRecords();
         void SendMotd(Player* currChar);
         void SendOfflineNameQueryResponses();
@@ -295,6 +299,7 @@ class WorldSession
         void QueuePacket(std::unique_ptr<WorldPacket> new_packet);
 
         void DeleteMovementPackets();
+        void ClearMapPackets();
 
         bool Update(uint32 diff);
         void UpdateMap(uint32 diff);
@@ -823,7 +828,8 @@ class WorldSession
         bool VerifyMovementInfo(MovementInfo const& movementInfo, Unit* mover, bool unroot) const;
         void HandleMoverRelocation(MovementInfo& movementInfo);
 
-        void ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& packet);
+        // inMapThread only tags the opcode metric, the packet processing class decides where it runs
+        void ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& packet, bool inMapThread = false);
 
         // logging helper
         void LogUnexpectedOpcode(WorldPacket const& packet, const char* reason) const;
@@ -877,10 +883,11 @@ class WorldSession
         bool m_initialZoneUpdated = false;
 
         // Thread safety mechanisms
-        std::mutex m_recvQueueLock;
-        std::mutex m_recvQueueMapLock;
-        std::deque<std::unique_ptr<WorldPacket>> m_recvQueue;
-        std::deque<std::unique_ptr<WorldPacket>> m_recvQueueMap;
+        std::mutex m_requestSocketLock;
+        // filled by the network threads, drained by World::UpdateSessions respectively the map of the player
+        MPSCQueue<std::unique_ptr<WorldPacket>> m_recvQueue;
+        MPSCQueue<std::unique_ptr<WorldPacket>> m_recvQueueMap;
+        std::deque<std::unique_ptr<WorldPacket>> m_recvQueueMapPending;  // drained map packets, only touched by their consumer
 
         Messager<WorldSession> m_messager;
 
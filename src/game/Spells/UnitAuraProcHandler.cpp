@@ -407,16 +407,54 @@ ProcExecutionData::ProcExecutionData(ProcSystemArguments& data, bool isVictim) :
     }
 }
 
+void Unit::AddProcAuraHolder(SpellAuraHolder* holder)
+{
+    SpellEntry const* spellProto = holder->GetSpellProto();
+    SpellProcEventEntry const* spellProcEvent = sSpellMgr.GetSpellProcEvent(spellProto->Id);
+    uint32 procFlags = spellProcEvent && spellProcEvent->procFlags ? spellProcEvent->procFlags : spellProto->procFlags;
+    if (!procFlags)
+        return;
+
+    // insert after holders of same spell id - same order as multimap insert into m_spellAuraHolders
+    uint32 spellId = holder->GetId();
+    auto itr = std::upper_bound(m_procAuraHolders.begin(), m_procAuraHolders.end(), spellId,
+        [](uint32 id, ProcAuraHolderEntry const& entry) { return id < entry.holder->GetId(); });
+    m_procAuraHolders.emplace(itr, procFlags, holder);
+    m_procAuraHoldersMask |= procFlags;
+}
+
+void Unit::RemoveProcAuraHolder(SpellAuraHolder* holder)
+{
+    auto itr = std::find_if(m_procAuraHolders.begin(), m_procAuraHolders.end(),
+        [holder](ProcAuraHolderEntry const& entry) { return entry.holder == holder; });
+    if (itr == m_procAuraHolders.end())
+        return;
+
+    m_procAuraHolders.erase(itr);
+
+    m_procAuraHoldersMask = 0;
+    for (ProcAuraHolderEntry const& entry : m_procAuraHolders)
+        m_procAuraHoldersMask |= entry.procFlags;
+}
+
 void Unit::ProcDamageAndSpellFor(ProcSystemArguments& argData, bool isVictim)
 {
+    // No holder can proc from any of the given flags
+    if ((m_procAuraHoldersMask & (isVictim ? argData.procFlagsVictim : argData.procFlagsAttacker)) == 0)
+        return;
+
     ProcExecutionData execData(argData, isVictim);
 
     ProcTriggeredList procTriggered;
     std::vector<SpellAuraHolder*> holdersForDeletion;
     // Fill procTriggered list
-    for (SpellAuraHolderMap::const_iterator itr = GetSpellAuraHolderMap().begin(); itr != GetSpellAuraHolderMap().end(); ++itr)
+    for (ProcAuraHolderEntry const& entry : m_procAuraHolders)
     {
-        SpellAuraHolder* holder = itr->second;
+        // holder can never pass IsSpellProcEventCanTriggeredBy for these flags
+        if ((entry.procFlags & execData.procFlags) == 0)
+            continue;
+
+        SpellAuraHolder* holder = entry.holder;
         // skip deleted auras (possible at recursive triggered call
         if (holder->GetState() != SPELLAURAHOLDER_STATE_READY || holder->IsDeleted())
             continue;
@@ -439,7 +477,7 @@ void Unit::ProcDamageAndSpellFor(ProcSystemArguments& argData, bool isVictim)
         if (result != SpellProcEventTriggerCheck::SPELL_PROC_TRIGGER_OK)
             continue;
 
-        procTriggered.push_back(ProcTriggeredData(spellProcEvent, itr->second));
+        procTriggered.push_back(ProcTriggeredData(spellProcEvent, holder));
     }
 
     for (SpellAuraHolder* holder : holdersForDeletion)
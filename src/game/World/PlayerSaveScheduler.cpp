@@ -0,0 +1,159 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "World/PlayerSaveScheduler.h"
+#include "World/World.h"
+#include "Entities/Player.h"
+#include "Globals/ObjectAccessor.h"
+#include "Maps/Map.h"
+#include "Util/Timer.h"
+
+#include <algorithm>
+
+INSTANTIATE_SINGLETON_1(PlayerSaveScheduler);
+
+// a pending item change counts as that long waiting when ordering the queue (ms)
+#define SAVE_WEIGHT_PRIORITY_TIME 1000
+// statement estimate before any save was seen
+#define DEFAULT_SAVE_STATEMENTS 40
+
+PlayerSaveScheduler::PlayerSaveScheduler() : m_grantedLastTick(0), m_statementsLastTick(0), m_totalSaves(0), m_totalStatements(0)
+{
+}
+
+bool PlayerSaveScheduler::IsEnabled() const
+{
+    return sWorld.getConfig(CONFIG_UINT32_PLAYER_SAVE_STATEMENTS_PER_TICK) != 0;
+}
+
+void PlayerSaveScheduler::RequestSave(Player* player)
+{
+    uint32 estimate = player->GetLastSaveStatements() ? player->GetLastSaveStatements() : GetAverageStatements();
+    AddRequest(player->GetObjectGuid(), player->GetPendingSaveWeight(), estimate);
+}
+
+void PlayerSaveScheduler::RetrySave(ObjectGuid guid)
+{
+    AddRequest(guid, 0, GetAverageStatements());
+}
+
+void PlayerSaveScheduler::AddRequest(ObjectGuid guid, uint32 weight, uint32 estimate)
+{
+    SaveRequest request;
+    request.guid = guid;
+    request.weight = weight;
+    request.estimate = estimate;
+    request.requestTime = WorldTimer::getMSTime();
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_pending.push_back(request);
+}
+
+void PlayerSaveScheduler::Update()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    m_grantedLastTick = 0;
+    m_statementsLastTick = 0;
+
+    if (m_pending.empty())
+        return;
+
+    uint32 budget = sWorld.getConfig(CONFIG_UINT32_PLAYER_SAVE_STATEMENTS_PER_TICK);
+    uint32 now = WorldTimer::getMSTime();
+
+    // longest waiting first, pending changes add to the waiting time
+    auto priority = [now](SaveRequest const& request)
+    {
+        return uint64(WorldTimer::getMSTimeDiff(request.requestTime, now)) + uint64(request.weight) * SAVE_WEIGHT_PRIORITY_TIME;
+    };
+    std::sort(m_pending.begin(), m_pending.end(), [&priority](SaveRequest const& lhs, SaveRequest const& rhs)
+    {
+        return priority(lhs) > priority(rhs);
+    });
+
+    std::vector<SaveRequest> remaining;
+    for (SaveRequest const& request : m_pending)
+    {
+        // budget spent, always let at least one save through so the queue keeps moving
+        if (budget && m_grantedLastTick && m_statementsLastTick + request.estimate > budget)
+        {
+            remaining.push_back(request);
+            continue;
+        }
+
+        Player* player = sObjectAccessor.FindPlayer(request.guid, false);
+        if (!player)                                        // logged out, saved at logout
+            continue;
+
+        if (!player->IsInWorld())                           // between maps, ask again next tick
+        {
+            remaining.push_back(request);
+            continue;
+        }
+
+        player->GetMap()->GetMessager().AddMessage([guid = request.guid](Map* map)
+        {
+            if (Player* player = map->GetPlayer(guid))
+            {
+                if (player->IsAutosavePending())            // not saved meanwhile
+                    player->SaveToDB();
+            }
+            else                                            // left the map meanwhile
+                sPlayerSaveScheduler.RetrySave(guid);
+        });
+
+        ++m_grantedLastTick;
+        m_statementsLastTick += request.estimate;
+    }
+
+    m_pending.swap(remaining);
+}
+
+void PlayerSaveScheduler::OnPlayerSaved(uint32 statements)
+{
+    ++m_totalSaves;
+    m_totalStatements += statements;
+}
+
+uint32 PlayerSaveScheduler::GetAverageStatements() const
+{
+    uint64 saves = m_totalSaves;
+    if (!saves)
+        return DEFAULT_SAVE_STATEMENTS;
+
+    return std::max(uint32(m_totalStatements / saves), uint32(1));
+}
+
+PlayerSaveSchedulerStats PlayerSaveScheduler::GetStats()
+{
+    PlayerSaveSchedulerStats stats;
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    uint32 now = WorldTimer::getMSTime();
+    stats.pending = uint32(m_pending.size());
+    stats.oldestWait = 0;
+    for (SaveRequest const& request : m_pending)
+        stats.oldestWait = std::max(stats.oldestWait, WorldTimer::getMSTimeDiff(request.requestTime, now));
+    stats.grantedLastTick = m_grantedLastTick;
+    stats.statementsLastTick = m_statementsLastTick;
+    stats.totalSaves = m_totalSaves;
+    stats.totalStatements = m_totalStatements;
+    return stats;
+}
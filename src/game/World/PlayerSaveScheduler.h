@@ -0,0 +1,94 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_PLAYER_SAVE_SCHEDULER_H
+#define MANGOS_PLAYER_SAVE_SCHEDULER_H
+
+#include "Common.h"
+#include "Entities/ObjectGuid.h"
+#include "Policies/Singleton.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+class Player;
+
+struct PlayerSaveSchedulerStats
+{
+    uint32 pending;                                         // autosaves waiting for a grant
+    uint32 oldestWait;                                      // ms the oldest of them waits already
+    uint32 grantedLastTick;
+    uint32 statementsLastTick;                              // estimated statements granted in the last tick
+    uint64 totalSaves;
+    uint64 totalStatements;
+};
+
+/**
+ * Spreads player autosaves over world ticks.
+ *
+ * With PlayerSave.MaxStatementsPerTick set, a player whose save timer expired asks for a save
+ * instead of saving on the spot. Each world tick grants queued saves until the estimated
+ * statement count reaches the budget, the granted saves run at the start of the player's
+ * next map update. Players with many pending item changes and players waiting longest go first.
+ */
+class PlayerSaveScheduler
+{
+    public:
+        PlayerSaveScheduler();
+
+        // budget configured, autosaves have to be requested
+        bool IsEnabled() const;
+
+        // map thread, autosave timer of the player expired
+        void RequestSave(Player* player);
+        // map thread, granted save found the player gone from the map
+        void RetrySave(ObjectGuid guid);
+
+        // world thread, while no map is updated
+        void Update();
+
+        // any thread, a player save wrote that many statements
+        void OnPlayerSaved(uint32 statements);
+
+        PlayerSaveSchedulerStats GetStats();
+
+    private:
+        struct SaveRequest
+        {
+            ObjectGuid guid;
+            uint32 weight;                                  // pending changes, see Player::GetPendingSaveWeight
+            uint32 estimate;                                // statements the save is expected to write
+            uint32 requestTime;                             // WorldTimer ms
+        };
+
+        void AddRequest(ObjectGuid guid, uint32 weight, uint32 estimate);
+        uint32 GetAverageStatements() const;
+
+        std::mutex m_lock;
+        std::vector<SaveRequest> m_pending;
+        uint32 m_grantedLastTick;
+        uint32 m_statementsLastTick;
+
+        std::atomic<uint64> m_totalSaves;
+        std::atomic<uint64> m_totalStatements;
+};
+
+#define sPlayerSaveScheduler MaNGOS::Singleton<PlayerSaveScheduler>::Instance()
+
+#endif
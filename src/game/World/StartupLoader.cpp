@@ -0,0 +1,142 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "World/StartupLoader.h"
+#include "Database/DatabaseEnv.h"
+#include "Log.h"
+#include "Util/Timer.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+
+StartupLoader::StartupLoader(char const* name, uint32 threads) : m_name(name), m_threads(threads)
+{
+}
+
+uint32 StartupLoader::AddStep(char const* name, std::function<void()> load, std::vector<uint32> const& dependsOn)
+{
+    uint32 id = uint32(m_steps.size());
+
+    Step step;
+    step.name = name;
+    step.load = std::move(load);
+    step.pendingDependencies = 0;
+    step.timeMs = 0;
+    m_steps.push_back(step);
+
+    for (uint32 dependency : dependsOn)
+    {
+        MANGOS_ASSERT(dependency < id);                     // only earlier steps, the graph can not have cycles
+        m_steps[dependency].dependents.push_back(id);
+        ++m_steps[id].pendingDependencies;
+    }
+
+    return id;
+}
+
+void StartupLoader::Run()
+{
+    uint32 startTime = WorldTimer::getMSTime();
+
+    // steps are added in a valid order, so one thread just runs them one by one
+    if (m_threads <= 1 || m_steps.size() <= 1)
+    {
+        for (Step& step : m_steps)
+            RunStep(step);
+    }
+    else
+        RunParallel();
+
+    Report(WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()));
+}
+
+void StartupLoader::RunStep(Step& step)
+{
+    uint32 stepStart = WorldTimer::getMSTime();
+    step.load();
+    step.timeMs = WorldTimer::getMSTimeDiff(stepStart, WorldTimer::getMSTime());
+}
+
+void StartupLoader::RunParallel()
+{
+    std::mutex lock;
+    std::condition_variable stateChanged;
+    std::set<uint32> ready;                                 // lowest id first, keeps the order close to the sequential one
+    uint32 finished = 0;
+
+    for (uint32 i = 0; i < m_steps.size(); ++i)
+        if (!m_steps[i].pendingDependencies)
+            ready.insert(i);
+
+    auto worker = [&]()
+    {
+        WorldDatabase.ThreadStart();
+        CharacterDatabase.ThreadStart();
+        LoginDatabase.ThreadStart();
+
+        std::unique_lock<std::mutex> guard(lock);
+        while (true)
+        {
+            stateChanged.wait(guard, [&]() { return !ready.empty() || finished == m_steps.size(); });
+            if (ready.empty())
+                break;
+
+            uint32 id = *ready.begin();
+            ready.erase(ready.begin());
+
+            guard.unlock();
+            RunStep(m_steps[id]);
+            guard.lock();
+
+            for (uint32 dependent : m_steps[id].dependents)
+                if (--m_steps[dependent].pendingDependencies == 0)
+                    ready.insert(dependent);
+
+            ++finished;
+            stateChanged.notify_all();
+        }
+        guard.unlock();
+
+        LoginDatabase.ThreadEnd();
+        CharacterDatabase.ThreadEnd();
+        WorldDatabase.ThreadEnd();
+    };
+
+    uint32 threadCount = std::min(m_threads, uint32(m_steps.size()));
+    std::vector<std::thread> threads;
+    for (uint32 i = 0; i < threadCount; ++i)
+        threads.emplace_back(worker);
+
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+void StartupLoader::Report(uint32 wallTimeMs) const
+{
+    uint32 sumMs = 0;
+    sLog.outString("%s load times:", m_name.c_str());
+    for (Step const& step : m_steps)
+    {
+        sLog.outString("    %6u ms  %s", step.timeMs, step.name.c_str());
+        sumMs += step.timeMs;
+    }
+    sLog.outString(">> %s: %u steps loaded in %u ms (%u ms one after another, %u threads)", m_name.c_str(), uint32(m_steps.size()), wallTimeMs, sumMs, std::max(m_threads, uint32(1)));
+    sLog.outString();
+}
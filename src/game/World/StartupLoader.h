@@ -0,0 +1,68 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_STARTUP_LOADER_H
+#define MANGOS_STARTUP_LOADER_H
+
+#include "Common.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Runs a group of startup load steps as a dependency graph.
+ *
+ * A step only starts once all steps it depends on are finished. With one thread the steps run
+ * in the order they were added, exactly like plain sequential calls. With more threads
+ * independent steps run at the same time, so a step may only be added without a dependency
+ * on another one when both write different containers and neither reads what the other writes.
+ * Queries of parallel steps share the connection pool, WorldDatabaseConnections limits
+ * how many queries really run in parallel.
+ */
+class StartupLoader
+{
+    public:
+        StartupLoader(char const* name, uint32 threads);
+
+        // returns the id to use in dependsOn of later steps
+        uint32 AddStep(char const* name, std::function<void()> load, std::vector<uint32> const& dependsOn = std::vector<uint32>());
+
+        // runs all steps and logs the time each one took
+        void Run();
+
+    private:
+        struct Step
+        {
+            std::string name;
+            std::function<void()> load;
+            std::vector<uint32> dependents;                 // steps waiting for this one
+            uint32 pendingDependencies;
+            uint32 timeMs;
+        };
+
+        void RunStep(Step& step);
+        void RunParallel();
+        void Report(uint32 wallTimeMs) const;
+
+        std::string m_name;
+        uint32 m_threads;
+        std::vector<Step> m_steps;
+};
+
+#endif
@@ -22,6 +22,7 @@
 
 #include "World/World.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/SQLStorage.h"
 #include "Config/Config.h"
 #include "Platform/Define.h"
 #include "SystemConfig.h"
@@ -66,6 +67,8 @@
 #include "Weather/Weather.h"
 #include "Cinematics/CinematicMgr.h"
 #include "World/WorldState.h"
+#include "World/PlayerSaveScheduler.h"
+#include "World/StartupLoader.h"
 #include "Maps/TransportMgr.h"
 #include "Anticheat/Anticheat.hpp"
 #include "LFG/LFGMgr.h"
@@ -124,7 +127,8 @@ uint32 World::m_maxDiff = 0;
 std::list<uint32> World::m_histDiff;
 
 /// World constructor
-World::World(): mail_timer(0), mail_timer_expires(0), m_NextWeeklyQuestReset(0), m_opcodeCounters(NUM_MSG_TYPES)
+World::World(): mail_timer(0), mail_timer_expires(0), m_NextWeeklyQuestReset(0), m_opcodeCounters(NUM_MSG_TYPES),
+    m_droppedPacketCount(0), m_droppedPacketBytes(0), m_skippedUpdateBlocks(0)
 {
     m_playerLimit = 0;
     m_allowMovement = true;
@@ -499,6 +503,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_AUTOLOAD_ACTIVE, "Autoload.Active", true);
 
     setConfig(CONFIG_UINT32_INTERVAL_SAVE, "PlayerSave.Interval", 15 * MINUTE * IN_MILLISECONDS);
+    setConfig(CONFIG_UINT32_PLAYER_SAVE_STATEMENTS_PER_TICK, "PlayerSave.MaxStatementsPerTick", 0);
     setConfigMinMax(CONFIG_UINT32_MIN_LEVEL_STAT_SAVE, "PlayerSave.Stats.MinLevel", 0, 0, MAX_LEVEL);
     setConfig(CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT, "PlayerSave.Stats.SaveOnlyOnLogout", true);
 
@@ -631,6 +636,16 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_UINT32_NUM_MAP_THREADS, "MapUpdate.Threads", 3);
+    setConfig(CONFIG_UINT32_STARTUP_LOAD_THREADS, "Startup.LoadThreads", 1);
+
+    setConfig(CONFIG_BOOL_AI_UPDATE_LOD, "AIUpdate.LOD.Enable", false);
+    setConfigMin(CONFIG_FLOAT_AI_UPDATE_LOD_ACTIVE_DISTANCE, "AIUpdate.LOD.ActiveDistance", 60.0f, 0.0f);
+    setConfigMin(CONFIG_FLOAT_AI_UPDATE_LOD_NEAR_DISTANCE, "AIUpdate.LOD.NearDistance", 200.0f, 0.0f);
+    setConfig(CONFIG_UINT32_AI_UPDATE_LOD_NEAR_INTERVAL, "AIUpdate.LOD.NearInterval", 400);
+    setConfig(CONFIG_UINT32_AI_UPDATE_LOD_FAR_INTERVAL, "AIUpdate.LOD.FarInterval", 1000);
+    setConfig(CONFIG_UINT32_AI_UPDATE_LOD_IDLE_INTERVAL, "AIUpdate.LOD.IdleInterval", 3000);
+    setConfig(CONFIG_UINT32_AI_UPDATE_LOD_TICK_BUDGET, "AIUpdate.LOD.TickBudget", 0);
+
     setConfig(CONFIG_UINT32_SKILL_CHANCE_ORANGE, "SkillChance.Orange", 100);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_YELLOW, "SkillChance.Yellow", 75);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_GREEN,  "SkillChance.Green",  25);
@@ -724,6 +739,8 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_OUTDOORPVP_EP_ENABLED,                       "OutdoorPvp.EPEnabled", true);
 
     setConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET, "Network.KickOnBadPacket", false);
+    setConfig(CONFIG_BOOL_OPCODE_STATISTICS, "Network.OpcodeStats", false);
+    opcodeTable.SetStatisticsEnabled(getConfig(CONFIG_BOOL_OPCODE_STATISTICS));
 
     setConfig(CONFIG_BOOL_PLAYER_COMMANDS, "PlayerCommands", true);
 
@@ -826,6 +843,18 @@ void World::LoadConfigSettings(bool reload)
         sLog.outString("Using DataDir %s", m_dataPath.c_str());
     }
 
+    ///- Read the table snapshot directory, empty keeps loading all tables from the database
+    std::string snapshotPath = sConfig.GetStringDefault("TableSnapshotDir", "");
+    if (!snapshotPath.empty() && snapshotPath.at(snapshotPath.length() - 1) != '/' && snapshotPath.at(snapshotPath.length() - 1) != '\\')
+        snapshotPath.append("/");
+
+    if (!reload)
+    {
+        SQLStorageBase::SetSnapshotDir(snapshotPath);
+        if (!snapshotPath.empty())
+            sLog.outString("Using TableSnapshotDir %s", snapshotPath.c_str());
+    }
+
     setConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK, "vmap.enableIndoorCheck", true);
     bool enableLOS = sConfig.GetBoolDefault("vmap.enableLOS", false);
     bool enableHeight = sConfig.GetBoolDefault("vmap.enableHeight", false);
@@ -1035,7 +1064,7 @@ void World::SetInitialWorldSettings()
 
     ///- Load the DBC files
     sLog.outString("Initialize DBC data stores...");
-    LoadDBCStores(m_dataPath);
+    LoadDBCStores(m_dataPath, getConfig(CONFIG_UINT32_STARTUP_LOAD_THREADS));
     DetectDBCLang();
     sObjectMgr.SetDbc2StorageLocaleIndex(GetDefaultDbcLocale());    // Get once for all the locale index of DBC language (console/broadcasts)
 
@@ -1092,35 +1121,72 @@ void World::SetInitialWorldSettings()
     // loads GO data
     sTransportMgr.LoadTransportAnimationAndRotation();
 
-    sLog.outString("Loading Spell Chain Data...");
-    sSpellMgr.LoadSpellChains();
+    {
+        // each step fills its own SpellMgr container and only reads spell_template and the spell chains
+        StartupLoader loader("Spell data", getConfig(CONFIG_UINT32_STARTUP_LOAD_THREADS));
+
+        uint32 chains = loader.AddStep("spell_chain", []()
+        {
+            sLog.outString("Loading Spell Chain Data...");
+            sSpellMgr.LoadSpellChains();
+        });
 
-    sLog.outString("Checking Spell Cone Data...");
-    sObjectMgr.CheckSpellCones();
+        loader.AddStep("spell_cone", []()
+        {
+            sLog.outString("Checking Spell Cone Data...");
+            sObjectMgr.CheckSpellCones();
+        }, { chains });
 
-    sLog.outString("Loading Spell Elixir types...");
-    sSpellMgr.LoadSpellElixirs();
+        loader.AddStep("spell_elixir", []()
+        {
+            sLog.outString("Loading Spell Elixir types...");
+            sSpellMgr.LoadSpellElixirs();
+        });
 
-    sLog.outString("Loading Spell Facing Flags...");
-    sSpellMgr.LoadFacingCasterFlags();
+        loader.AddStep("spell_facing", []()
+        {
+            sLog.outString("Loading Spell Facing Flags...");
+            sSpellMgr.LoadFacingCasterFlags();
+        });
 
-    sLog.outString("Loading Spell Learn Skills...");
-    sSpellMgr.LoadSpellLearnSkills();                       // must be after LoadSpellChains
+        loader.AddStep("SpellLearnSkills", []()
+        {
+            sLog.outString("Loading Spell Learn Skills...");
+            sSpellMgr.LoadSpellLearnSkills();
+        }, { chains });
 
-    sLog.outString("Loading Spell Learn Spells...");
-    sSpellMgr.LoadSpellLearnSpells();
+        loader.AddStep("spell_learn_spell", []()
+        {
+            sLog.outString("Loading Spell Learn Spells...");
+            sSpellMgr.LoadSpellLearnSpells();
+        });
 
-    sLog.outString("Loading Spell Proc Event conditions...");
-    sSpellMgr.LoadSpellProcEvents();
+        loader.AddStep("spell_proc_event", []()
+        {
+            sLog.outString("Loading Spell Proc Event conditions...");
+            sSpellMgr.LoadSpellProcEvents();
+        }, { chains });
 
-    sLog.outString("Loading Spell Bonus Data...");
-    sSpellMgr.LoadSpellBonuses();
+        loader.AddStep("spell_bonus_data", []()
+        {
+            sLog.outString("Loading Spell Bonus Data...");
+            sSpellMgr.LoadSpellBonuses();
+        }, { chains });
 
-    sLog.outString("Loading Spell Proc Item Enchant...");
-    sSpellMgr.LoadSpellProcItemEnchant();                   // must be after LoadSpellChains
+        loader.AddStep("spell_proc_item_enchant", []()
+        {
+            sLog.outString("Loading Spell Proc Item Enchant...");
+            sSpellMgr.LoadSpellProcItemEnchant();
+        }, { chains });
 
-    sLog.outString("Loading Aggro Spells Definitions...");
-    sSpellMgr.LoadSpellThreats();
+        loader.AddStep("spell_threat", []()
+        {
+            sLog.outString("Loading Aggro Spells Definitions...");
+            sSpellMgr.LoadSpellThreats();
+        }, { chains });
+
+        loader.Run();
+    }
 
     sLog.outString("Loading NPC Texts...");
     sObjectMgr.LoadGossipText();
@@ -1164,23 +1230,48 @@ void World::SetInitialWorldSettings()
     sLog.outString("Loading Creature template spells...");
     sObjectMgr.LoadCreatureTemplateSpells();
 
-    sLog.outString("Loading ItemRequiredTarget...");
-    sObjectMgr.LoadItemRequiredTarget();
+    {
+        // independent tables, each step fills its own ObjectMgr container and only reads templates loaded above
+        StartupLoader loader("Creature and item extras", getConfig(CONFIG_UINT32_STARTUP_LOAD_THREADS));
 
-    sLog.outString("Loading Reputation Reward Rates...");
-    sObjectMgr.LoadReputationRewardRate();
+        loader.AddStep("item_required_target", []()
+        {
+            sLog.outString("Loading ItemRequiredTarget...");
+            sObjectMgr.LoadItemRequiredTarget();
+        });
 
-    sLog.outString("Loading Creature Reputation OnKill Data...");
-    sObjectMgr.LoadReputationOnKill();
+        loader.AddStep("reputation_reward_rate", []()
+        {
+            sLog.outString("Loading Reputation Reward Rates...");
+            sObjectMgr.LoadReputationRewardRate();
+        });
 
-    sLog.outString("Loading Reputation Spillover Data...");
-    sObjectMgr.LoadReputationSpilloverTemplate();
+        loader.AddStep("creature_onkill_reputation", []()
+        {
+            sLog.outString("Loading Creature Reputation OnKill Data...");
+            sObjectMgr.LoadReputationOnKill();
+        });
 
-    sLog.outString("Loading Points Of Interest Data...");
-    sObjectMgr.LoadPointsOfInterest();
+        loader.AddStep("reputation_spillover_template", []()
+        {
+            sLog.outString("Loading Reputation Spillover Data...");
+            sObjectMgr.LoadReputationSpilloverTemplate();
+        });
 
-    sLog.outString("Loading Pet Create Spells...");
-    sObjectMgr.LoadPetCreateSpells();
+        loader.AddStep("points_of_interest", []()
+        {
+            sLog.outString("Loading Points Of Interest Data...");
+            sObjectMgr.LoadPointsOfInterest();
+        });
+
+        loader.AddStep("petcreateinfo_spell", []()
+        {
+            sLog.outString("Loading Pet Create Spells...");
+            sObjectMgr.LoadPetCreateSpells();
+        });
+
+        loader.Run();
+    }
 
     sLog.outString("Loading Creature Conditional Spawn Data...");  // must be after LoadCreatureTemplates and before LoadCreatures
     sObjectMgr.LoadCreatureConditionalSpawn();
@@ -1258,6 +1349,7 @@ void World::SetInitialWorldSettings()
 
     sLog.outString("Loading Gameobject Respawn Data...");   // must be after LoadGameObjects(), and sMapPersistentStateMgr.InitWorldMaps()
     sMapPersistentStateMgr.LoadGameobjectRespawnTimes();
+    sMapPersistentStateMgr.HibernateUnusedStates();        // must be after all respawn times are loaded
 
     sLog.outString("Loading SpellArea Data...");            // must be after quest load
     sSpellMgr.LoadSpellAreas();
@@ -1797,6 +1889,7 @@ void World::Update(uint32 diff)
 #ifdef BUILD_METRICS
     auto preMapTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
 #endif
+    sPlayerSaveScheduler.Update();
     sMapMgr.Update(diff);
 #ifdef BUILD_METRICS
     auto postMapTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
@@ -2805,6 +2898,25 @@ void World::GeneratePacketMetrics()
         m_opcodeCounters[i] = 0;
     }
 
+    if (opcodeTable.IsStatisticsEnabled())
+    {
+        // handler statistics are totals since startup or the last .debug perf opcodes reset
+        for (OpcodeStatisticsSummary const& stats : opcodeTable.GetStatistics())
+        {
+            metric::measurement meas("world.metrics.packets.handled", { {"opcode", opcodeTable[stats.opcode].name} });
+            meas.add_field("count", std::to_string(stats.count));
+            meas.add_field("bytes", std::to_string(stats.bytes));
+            meas.add_field("time_us", std::to_string(stats.timeUs));
+            meas.add_field("p50_us", std::to_string(stats.p50Us));
+            meas.add_field("p99_us", std::to_string(stats.p99Us));
+        }
+    }
+
+    metric::measurement meas_skipped("world.metrics.packets.skipped");
+    meas_skipped.add_field("dropped_count", std::to_string(m_droppedPacketCount.exchange(0)));
+    meas_skipped.add_field("dropped_bytes", std::to_string(m_droppedPacketBytes.exchange(0)));
+    meas_skipped.add_field("update_blocks", std::to_string(m_skippedUpdateBlocks.exchange(0)));
+
     metric::measurement meas_players("world.metrics.players");
     meas_players.add_field("online", std::to_string(GetActiveSessionCount()));
     meas_players.add_field("unique", std::to_string(GetUniqueSessionCount()));
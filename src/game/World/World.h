@@ -92,6 +92,7 @@ enum eConfigUInt32Values
 {
     CONFIG_UINT32_COMPRESSION = 0,
     CONFIG_UINT32_INTERVAL_SAVE,
+    CONFIG_UINT32_PLAYER_SAVE_STATEMENTS_PER_TICK,
     CONFIG_UINT32_INTERVAL_GRIDCLEAN,
     CONFIG_UINT32_INTERVAL_MAPUPDATE,
     CONFIG_UINT32_INTERVAL_CHANGEWEATHER,
@@ -141,6 +142,7 @@ enum eConfigUInt32Values
     CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK,
     CONFIG_UINT32_UPTIME_UPDATE,
     CONFIG_UINT32_NUM_MAP_THREADS,
+    CONFIG_UINT32_STARTUP_LOAD_THREADS,
     CONFIG_UINT32_AUCTION_DEPOSIT_MIN,
     CONFIG_UINT32_SKILL_CHANCE_ORANGE,
     CONFIG_UINT32_SKILL_CHANCE_YELLOW,
@@ -198,6 +200,10 @@ enum eConfigUInt32Values
     CONFIG_UINT32_CREATURE_PICKPOCKET_RESTOCK_DELAY,
     CONFIG_UINT32_CHANNEL_STATIC_AUTO_TRESHOLD,
     CONFIG_UINT32_LFG_MATCHMAKING_TIMER,
+    CONFIG_UINT32_AI_UPDATE_LOD_NEAR_INTERVAL,
+    CONFIG_UINT32_AI_UPDATE_LOD_FAR_INTERVAL,
+    CONFIG_UINT32_AI_UPDATE_LOD_IDLE_INTERVAL,
+    CONFIG_UINT32_AI_UPDATE_LOD_TICK_BUDGET,
     //Start Solocraft Defines
     //Level Thresholds
     CONFIG_UINT32_SOLOCRAFT_MAX_LEVEL_DIFF,
@@ -329,6 +335,8 @@ enum eConfigFloatValues
     CONFIG_FLOAT_GHOST_RUN_SPEED_WORLD,
     CONFIG_FLOAT_GHOST_RUN_SPEED_BG,
     CONFIG_FLOAT_LEASH_RADIUS,
+    CONFIG_FLOAT_AI_UPDATE_LOD_ACTIVE_DISTANCE,
+    CONFIG_FLOAT_AI_UPDATE_LOD_NEAR_DISTANCE,
     CONFIG_FLOAT_WAREFFORT_RATES,
     //Start Solocraft Defines
     //Balancing
@@ -431,6 +439,7 @@ enum eConfigBoolValues
     CONFIG_BOOL_OUTDOORPVP_SI_ENABLED,
     CONFIG_BOOL_OUTDOORPVP_EP_ENABLED,
     CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET,
+    CONFIG_BOOL_OPCODE_STATISTICS,
     CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT,
     CONFIG_BOOL_CLEAN_CHARACTER_DB,
     CONFIG_BOOL_VMAP_INDOOR_CHECK,
@@ -445,6 +454,7 @@ enum eConfigBoolValues
     CONFIG_BOOL_AUTOLOAD_ACTIVE,
     CONFIG_BOOL_PATH_FIND_OPTIMIZE,
     CONFIG_BOOL_PATH_FIND_NORMALIZE_Z,
+    CONFIG_BOOL_AI_UPDATE_LOD,
     CONFIG_BOOL_LFG_MATCHMAKING,
     CONFIG_BOOL_LFG_TELEPORT,
     CONFIG_BOOL_WAREFFORT_ENABLE,
@@ -748,6 +758,9 @@ class World
         Messager<World>& GetMessager() { return m_messager; }
 
         void IncrementOpcodeCounter(uint32 opcodeId); // thread safe due to atomics
+        // packets built for sessions without reader and update blocks not built at all for them
+        void AddDroppedPacket(size_t bytes) { ++m_droppedPacketCount; m_droppedPacketBytes += bytes; } // thread safe due to atomics
+        void IncrementSkippedUpdateBlocks() { ++m_skippedUpdateBlocks; } // thread safe due to atomics
 
         void LoadWorldSafeLocs() const;
         void LoadGraveyardZones();
@@ -867,6 +880,9 @@ class World
 
         // Opcode logging
         std::vector<std::atomic<uint32>> m_opcodeCounters;
+        std::atomic<uint64> m_droppedPacketCount;
+        std::atomic<uint64> m_droppedPacketBytes;
+        std::atomic<uint64> m_skippedUpdateBlocks;
         // online count logging
         std::array<std::atomic<uint32>, 2> m_onlineTeams;
         std::array<std::atomic<uint32>, MAX_RACES> m_onlineRaces;
@@ -0,0 +1,89 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/** \file
+    \ingroup realmd
+*/
+
+#include "AuthQueryPool.h"
+#include "Database/DatabaseEnv.h"
+
+extern DatabaseType LoginDatabase;
+
+AuthQueryPool::AuthQueryPool() : m_running(false)
+{
+}
+
+AuthQueryPool& AuthQueryPool::Instance()
+{
+    static AuthQueryPool pool;
+    return pool;
+}
+
+AuthQueryPool::~AuthQueryPool()
+{
+    Stop();
+}
+
+void AuthQueryPool::Start(uint32 threads)
+{
+    if (!m_threads.empty())
+        return;
+
+    m_service.reset();
+    m_work.reset(new boost::asio::io_service::work(m_service));
+
+    for (uint32 i = 0; i < threads; ++i)
+    {
+        m_threads.emplace_back([this]
+        {
+            LoginDatabase.ThreadStart();
+            boost::system::error_code ec;
+            m_service.run(ec);
+            LoginDatabase.ThreadEnd();
+        });
+    }
+
+    m_running = !m_threads.empty();
+}
+
+void AuthQueryPool::Stop()
+{
+    if (m_threads.empty())
+        return;
+
+    // let the queued jobs finish, their results are dropped by closed sockets
+    m_running = false;
+    m_work.reset();
+    for (std::thread& thread : m_threads)
+        if (thread.joinable())
+            thread.join();
+
+    m_threads.clear();
+}
+
+void AuthQueryPool::Post(std::function<void()> job)
+{
+    if (!m_running)
+    {
+        job();
+        return;
+    }
+
+    m_service.post(std::move(job));
+}
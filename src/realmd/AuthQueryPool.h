@@ -0,0 +1,62 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \addtogroup realmd
+/// @{
+/// \file
+
+#ifndef _AUTHQUERYPOOL_H
+#define _AUTHQUERYPOOL_H
+
+#include "Common.h"
+
+#include <boost/asio.hpp>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/// Worker threads running the login database queries of the auth sockets, so the network threads never wait for MySQL
+class AuthQueryPool
+{
+    public:
+        static AuthQueryPool& Instance();
+
+        AuthQueryPool();
+        ~AuthQueryPool();
+
+        void Start(uint32 threads);
+        void Stop();
+
+        /// Runs the job on a worker thread, inline when no worker is running
+        void Post(std::function<void()> job);
+
+    private:
+        boost::asio::io_service m_service;
+        // note that the work member *must* be declared after the service member for the work constructor to function correctly
+        std::unique_ptr<boost::asio::io_service::work> m_work;
+        std::vector<std::thread> m_threads;
+        std::atomic<bool> m_running;
+};
+
+#define sAuthQueryPool AuthQueryPool::Instance()
+
+#endif
+/// @}
@@ -29,9 +29,11 @@
 #include "RealmList.h"
 #include "AuthSocket.h"
 #include "AuthCodes.h"
+#include "AuthQueryPool.h"
 #include "Auth/SRP6.h"
 #include "Util/CommonDefines.h"
 
+#include <cerrno>
 #include <openssl/md5.h>
 #include <ctime>
 #include <memory>
@@ -179,7 +181,8 @@ std::array<uint8, 16> VersionChallenge = { { 0xBA, 0xA3, 0x1E, 0x99, 0xA0, 0x0B,
 
 /// Constructor - set the N and g values for SRP6
 AuthSocket::AuthSocket(boost::asio::io_service& service, std::function<void (Socket*)> closeHandler)
-    : Socket(service, std::move(closeHandler)), _status(STATUS_CHALLENGE), _build(0), _accountSecurityLevel(SEC_PLAYER), m_timeoutTimer(service)
+    : Socket(service, std::move(closeHandler)), _status(STATUS_CHALLENGE), _build(0), _accountId(0), _accountSecurityLevel(SEC_PLAYER),
+      m_realmListQueried(false), m_realmListSecurityLevel(0), m_service(service), m_timeoutTimer(service)
 {
 }
 
@@ -200,6 +203,37 @@ bool AuthSocket::Open()
     return Socket::Open();
 }
 
+void AuthSocket::RunDBQuery(std::function<void()> query, std::function<void()> resume)
+{
+    ///- Suspend command processing, the client waits for our answer before it sends anything else
+    _status = STATUS_WAIT_DB;
+
+    std::shared_ptr<AuthSocket> self = shared<AuthSocket>();
+    sAuthQueryPool.Post([self, query, resume]()
+    {
+        query();
+
+        self->m_service.post([self, resume]()
+        {
+            if (self->IsClosed())
+                return;
+
+            resume();
+            self->ProcessPendingData();
+        });
+    });
+}
+
+/// Handle the commands the client sent while the login database was queried
+void AuthSocket::ProcessPendingData()
+{
+    if (IsClosed() || _status == STATUS_WAIT_DB || ReadLengthRemaining() <= 0)
+        return;
+
+    if (!ProcessIncomingData() && errno != EBADMSG && !IsClosed())
+        Close();
+}
+
 /// Read the packet from the client
 bool AuthSocket::ProcessIncomingData()
 {
@@ -222,6 +256,13 @@ bool AuthSocket::ProcessIncomingData()
     // which presumably the client will never do, but lets support it anyway! \o/
     while (ReadLengthRemaining() > 0)
     {
+        // keep the rest in the buffer until the login database answered, ProcessPendingData continues with it
+        if (_status == STATUS_WAIT_DB)
+        {
+            errno = EBADMSG;
+            return false;
+        }
+
         const eAuthCmd cmd = static_cast<eAuthCmd>(*InPeak());
         int i;
 
@@ -348,8 +389,6 @@ bool AuthSocket::_HandleLogonChallenge()
     EndianConvert(ch->timezone_bias);
     EndianConvert(ch->ip);
 
-    ByteBuffer pkt;
-
     _login = (const char*)ch->I;
     _build = ch->build;
 
@@ -376,139 +415,161 @@ bool AuthSocket::_HandleLogonChallenge()
     LoginDatabase.escape_string(_safelocale);
     LoginDatabase.escape_string(m_os);
 
+    ///- Look up ip ban, account and account ban on the query pool
+    std::shared_ptr<LogonChallengeQuery> query = std::make_shared<LogonChallengeQuery>();
+    std::string address = m_address;
+    std::string safelogin = _safelogin;
+    RunDBQuery([query, address, safelogin]()
+    {
+        ///- Verify that this IP is not in the ip_banned table
+        // No SQL injection possible (paste the IP address as passed by the socket)
+        std::unique_ptr<QueryResult> ip_banned_result(LoginDatabase.PQuery("SELECT expires_at FROM ip_banned "
+                "WHERE (expires_at = banned_at OR expires_at > UNIX_TIMESTAMP()) AND ip = '%s'", address.c_str()));
+        if (ip_banned_result)
+        {
+            query->ipBanned = true;
+            return;
+        }
+
+        ///- Get the account details from the account table
+        // No SQL injection (escaped user name)
+        query->account.reset(LoginDatabase.PQuery("SELECT id,locked,lockedIp,gmlevel,v,s,token FROM account WHERE username = '%s'", safelogin.c_str()));
+        if (!query->account)
+            return;
+
+        query->accountBan.reset(LoginDatabase.PQuery("SELECT banned_at,expires_at FROM account_banned WHERE "
+                                "account_id = %u AND active = 1 AND (expires_at > UNIX_TIMESTAMP() OR expires_at = banned_at)", query->account->Fetch()[0].GetUInt32()));
+    }, [this, query]()
+    {
+        _HandleLogonChallengeResult(*query);
+    });
+
+    return true;
+}
+
+void AuthSocket::_HandleLogonChallengeResult(LogonChallengeQuery const& query)
+{
+    ///- Session is closed unless overriden
+    _status = STATUS_CLOSED;
+
+    ByteBuffer pkt;
     pkt << uint8(CMD_AUTH_LOGON_CHALLENGE);
     pkt << uint8(0x00);
 
-    ///- Verify that this IP is not in the ip_banned table
-    // No SQL injection possible (paste the IP address as passed by the socket)
-    std::unique_ptr<QueryResult> ip_banned_result(LoginDatabase.PQuery("SELECT expires_at FROM ip_banned "
-            "WHERE (expires_at = banned_at OR expires_at > UNIX_TIMESTAMP()) AND ip = '%s'", m_address.c_str()));
-
-    if (ip_banned_result)
+    if (query.ipBanned)
     {
         pkt << uint8(AUTH_LOGON_FAILED_FAIL_NOACCESS);
         BASIC_LOG("[AuthChallenge] Banned ip %s tries to login!", m_address.c_str());
     }
-    else
+    else if (QueryResult* result = query.account.get())
     {
-        ///- Get the account details from the account table
-        // No SQL injection (escaped user name)
-        QueryResult* result = LoginDatabase.PQuery("SELECT id,locked,lockedIp,gmlevel,v,s,token FROM account WHERE username = '%s'", _safelogin.c_str());
-        if (result)
-        {
-            Field* fields = result->Fetch();
+        Field* fields = result->Fetch();
 
-            ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
-            bool locked = false;
-            if (fields[1].GetUInt8() == 1)               // if ip is locked
+        ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
+        bool locked = false;
+        if (fields[1].GetUInt8() == 1)                   // if ip is locked
+        {
+            DEBUG_LOG("[AuthChallenge] Account '%s' is locked to IP - '%s'", _login.c_str(), fields[2].GetString());
+            DEBUG_LOG("[AuthChallenge] Player address is '%s'", m_address.c_str());
+            if (strcmp(fields[2].GetString(), m_address.c_str()))
             {
-                DEBUG_LOG("[AuthChallenge] Account '%s' is locked to IP - '%s'", _login.c_str(), fields[2].GetString());
-                DEBUG_LOG("[AuthChallenge] Player address is '%s'", m_address.c_str());
-                if (strcmp(fields[2].GetString(), m_address.c_str()))
-                {
-                    DEBUG_LOG("[AuthChallenge] Account IP differs");
-                    pkt << uint8(AUTH_LOGON_FAILED_SUSPENDED);
-                    locked = true;
-                }
-                else
-                    DEBUG_LOG("[AuthChallenge] Account IP matches");
+                DEBUG_LOG("[AuthChallenge] Account IP differs");
+                pkt << uint8(AUTH_LOGON_FAILED_SUSPENDED);
+                locked = true;
             }
             else
-                DEBUG_LOG("[AuthChallenge] Account '%s' is not locked to ip", _login.c_str());
+                DEBUG_LOG("[AuthChallenge] Account IP matches");
+        }
+        else
+            DEBUG_LOG("[AuthChallenge] Account '%s' is not locked to ip", _login.c_str());
 
-            std::string databaseV = fields[4].GetCppString();
-            std::string databaseS = fields[5].GetCppString();
-            bool broken = false;
+        std::string databaseV = fields[4].GetCppString();
+        std::string databaseS = fields[5].GetCppString();
+        bool broken = false;
 
-            if (!srp.SetVerifier(databaseV.c_str()) || !srp.SetSalt(databaseS.c_str()))
-            {
-                pkt << uint8(AUTH_LOGON_FAILED_FAIL_NOACCESS);
-                DEBUG_LOG("[AuthChallenge] Broken v/s values in database for account %s!", _login.c_str());
-                broken = true;
-            }
+        if (!srp.SetVerifier(databaseV.c_str()) || !srp.SetSalt(databaseS.c_str()))
+        {
+            pkt << uint8(AUTH_LOGON_FAILED_FAIL_NOACCESS);
+            DEBUG_LOG("[AuthChallenge] Broken v/s values in database for account %s!", _login.c_str());
+            broken = true;
+        }
 
-            if (!locked && !broken)
+        if (!locked && !broken)
+        {
+            ///- If the account is banned, reject the logon attempt
+            if (QueryResult* banresult = query.accountBan.get())
             {
-                ///- If the account is banned, reject the logon attempt
-                QueryResult* banresult = LoginDatabase.PQuery("SELECT banned_at,expires_at FROM account_banned WHERE "
-                                         "account_id = %u AND active = 1 AND (expires_at > UNIX_TIMESTAMP() OR expires_at = banned_at)", fields[0].GetUInt32());
-                if (banresult)
+                if ((*banresult)[0].GetUInt64() == (*banresult)[1].GetUInt64())
                 {
-                    if ((*banresult)[0].GetUInt64() == (*banresult)[1].GetUInt64())
-                    {
-                        pkt << uint8(AUTH_LOGON_FAILED_BANNED);
-                        BASIC_LOG("[AuthChallenge] Banned account %s tries to login!", _login.c_str());
-                    }
-                    else
-                    {
-                        pkt << uint8(AUTH_LOGON_FAILED_SUSPENDED);
-                        BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", _login.c_str());
-                    }
-
-                    delete banresult;
+                    pkt << uint8(AUTH_LOGON_FAILED_BANNED);
+                    BASIC_LOG("[AuthChallenge] Banned account %s tries to login!", _login.c_str());
                 }
                 else
                 {
-                    DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
+                    pkt << uint8(AUTH_LOGON_FAILED_SUSPENDED);
+                    BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", _login.c_str());
+                }
+            }
+            else
+            {
+                DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
 
-                    BigNumber s;
-                    s.SetHexStr(databaseS.c_str());
+                BigNumber s;
+                s.SetHexStr(databaseS.c_str());
 
-                    srp.CalculateHostPublicEphemeral();
+                srp.CalculateHostPublicEphemeral();
 
-                    ///- Fill the response packet with the result
-                    pkt << uint8(AUTH_LOGON_SUCCESS);
+                ///- Fill the response packet with the result
+                pkt << uint8(AUTH_LOGON_SUCCESS);
 
-                    // B may be calculated < 32B so we force minimal length to 32B
-                    pkt.append(srp.GetHostPublicEphemeral().AsByteArray(32));      // 32 bytes
-                    pkt << uint8(1);
-                    pkt.append(srp.GetGeneratorModulo().AsByteArray());
-                    pkt << uint8(32);
-                    pkt.append(srp.GetPrime().AsByteArray(32));
-                    pkt.append(s.AsByteArray());// 32 bytes
-                    pkt.append(VersionChallenge.data(), VersionChallenge.size());
-                    uint8 securityFlags = 0;
+                // B may be calculated < 32B so we force minimal length to 32B
+                pkt.append(srp.GetHostPublicEphemeral().AsByteArray(32));      // 32 bytes
+                pkt << uint8(1);
+                pkt.append(srp.GetGeneratorModulo().AsByteArray());
+                pkt << uint8(32);
+                pkt.append(srp.GetPrime().AsByteArray(32));
+                pkt.append(s.AsByteArray());// 32 bytes
+                pkt.append(VersionChallenge.data(), VersionChallenge.size());
+                uint8 securityFlags = 0;
 
-                    _token = fields[6].GetCppString();
-                    if (!_token.empty() && _build >= 8606) // authenticator was added in 2.4.3
-                        securityFlags = SECURITY_FLAG_AUTHENTICATOR;
+                _token = fields[6].GetCppString();
+                if (!_token.empty() && _build >= 8606) // authenticator was added in 2.4.3
+                    securityFlags = SECURITY_FLAG_AUTHENTICATOR;
 
-                    pkt << uint8(securityFlags);                    // security flags (0x0...0x04)
+                pkt << uint8(securityFlags);                    // security flags (0x0...0x04)
 
-                    if (securityFlags & SECURITY_FLAG_PIN)          // PIN input
-                    {
-                        pkt << uint32(0);
-                        pkt << uint64(0);
-                        pkt << uint64(0);
-                    }
+                if (securityFlags & SECURITY_FLAG_PIN)          // PIN input
+                {
+                    pkt << uint32(0);
+                    pkt << uint64(0);
+                    pkt << uint64(0);
+                }
 
-                    if (securityFlags & SECURITY_FLAG_UNK)          // Matrix input
-                    {
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint64(0);
-                    }
+                if (securityFlags & SECURITY_FLAG_UNK)          // Matrix input
+                {
+                    pkt << uint8(0);
+                    pkt << uint8(0);
+                    pkt << uint8(0);
+                    pkt << uint8(0);
+                    pkt << uint64(0);
+                }
 
-                    if (securityFlags & SECURITY_FLAG_AUTHENTICATOR)    // Authenticator input
-                        pkt << uint8(1);
+                if (securityFlags & SECURITY_FLAG_AUTHENTICATOR)    // Authenticator input
+                    pkt << uint8(1);
 
-                    uint8 secLevel = fields[3].GetUInt8();
-                    _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
+                _accountId = fields[0].GetUInt32();
+                uint8 secLevel = fields[3].GetUInt8();
+                _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
 
-                    ///- All good, await client's proof
-                    _status = STATUS_LOGON_PROOF;
-                }
+                ///- All good, await client's proof
+                _status = STATUS_LOGON_PROOF;
             }
-            delete result;
         }
-        else                                                // no account
-            pkt << uint8(AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT);
     }
+    else                                                    // no account
+        pkt << uint8(AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT);
 
     Write((const char*)pkt.contents(), pkt.size());
-    return true;
 }
 
 /// Logon Proof command handler
@@ -595,10 +656,9 @@ bool AuthSocket::_HandleLogonProof()
         ///- Update the sessionkey, current ip and login time and reset number of failed logins in the account table for this account
         // No SQL injection (escaped user input) and IP address as received by socket
         const char* K_hex = srp.GetStrongSessionKey().AsHexStr();
+        // Both statements go through the async DB thread, the account id is known since the challenge
         LoginDatabase.PExecute("UPDATE account SET sessionkey = '%s', locale = '%s', failed_logins = 0, os = '%s', platform = '%s' WHERE username = '%s'", K_hex, _safelocale.c_str(), m_os.c_str(), m_platform.c_str(), _safelogin.c_str());
-        std::unique_ptr<QueryResult> loginfail(LoginDatabase.PQuery("SELECT id FROM account WHERE username = '%s'", _safelogin.c_str()));
-        if (loginfail)
-            LoginDatabase.PExecute("INSERT INTO account_logons(accountId,ip,loginTime,loginSource) VALUES('%u','%s',NOW(),'%u')", loginfail->Fetch()[0].GetUInt32(), m_address.c_str(), LOGIN_TYPE_REALMD);
+        LoginDatabase.PExecute("INSERT INTO account_logons(accountId,ip,loginTime,loginSource) VALUES('%u','%s',NOW(),'%u')", _accountId, m_address.c_str(), LOGIN_TYPE_REALMD);
         OPENSSL_free((void*)K_hex);
 
         ///- Finish SRP6 and send the final result to the client
@@ -629,11 +689,21 @@ bool AuthSocket::_HandleLogonProof()
         uint32 MaxWrongPassCount = sConfig.GetIntDefault("WrongPass.MaxCount", 0);
         if (MaxWrongPassCount > 0)
         {
-            // Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
-            LoginDatabase.PExecute("UPDATE account SET failed_logins = failed_logins + 1 WHERE username = '%s'", _safelogin.c_str());
-
-            if (QueryResult* loginfail = LoginDatabase.PQuery("SELECT id, failed_logins FROM account WHERE username = '%s'", _safelogin.c_str()))
+            // The answer is sent already, nothing has to wait for the counting
+            std::string login = _login;
+            std::string safelogin = _safelogin;
+            std::string current_ip = m_address;
+            LoginDatabase.escape_string(current_ip);
+            sAuthQueryPool.Post([MaxWrongPassCount, login, safelogin, current_ip]()
             {
+                // Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
+                // Executed directly, the count read back below has to include this attempt
+                LoginDatabase.DirectPExecute("UPDATE account SET failed_logins = failed_logins + 1 WHERE username = '%s'", safelogin.c_str());
+
+                std::unique_ptr<QueryResult> loginfail(LoginDatabase.PQuery("SELECT id, failed_logins FROM account WHERE username = '%s'", safelogin.c_str()));
+                if (!loginfail)
+                    return;
+
                 Field* fields = loginfail->Fetch();
                 uint32 failed_logins = fields[1].GetUInt32();
 
@@ -649,20 +719,17 @@ bool AuthSocket::_HandleLogonProof()
                                                "VALUES ('%u',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban',1)",
                                                acc_id, WrongPassBanTime);
                         BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
-                                  _login.c_str(), WrongPassBanTime, failed_logins);
+                                  login.c_str(), WrongPassBanTime, failed_logins);
                     }
                     else
                     {
-                        std::string current_ip = m_address;
-                        LoginDatabase.escape_string(current_ip);
                         LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban')",
                                                current_ip.c_str(), WrongPassBanTime);
                         BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
-                                  current_ip.c_str(), WrongPassBanTime, _login.c_str(), failed_logins);
+                                  current_ip.c_str(), WrongPassBanTime, login.c_str(), failed_logins);
                     }
                 }
-                delete loginfail;
-            }
+            });
         }
     }
     return true;
@@ -711,31 +778,40 @@ bool AuthSocket::_HandleReconnectChallenge()
     EndianConvert(ch->build);
     _build = ch->build;
 
-    QueryResult* result = LoginDatabase.PQuery("SELECT sessionkey FROM account WHERE username = '%s'", _safelogin.c_str());
-
-    // Stop if the account is not found
-    if (!result)
+    std::shared_ptr<std::unique_ptr<QueryResult>> query = std::make_shared<std::unique_ptr<QueryResult>>();
+    std::string safelogin = _safelogin;
+    RunDBQuery([query, safelogin]()
     {
-        sLog.outError("[ERROR] user %s tried to login and we cannot find his session key in the database.", _login.c_str());
-        Close();
-        return false;
-    }
+        query->reset(LoginDatabase.PQuery("SELECT sessionkey FROM account WHERE username = '%s'", safelogin.c_str()));
+    }, [this, query]()
+    {
+        _status = STATUS_CLOSED;
 
-    Field* fields = result->Fetch();
-    srp.SetStrongSessionKey(fields[0].GetString());
-    delete result;
+        // Stop if the account is not found
+        QueryResult* result = query->get();
+        if (!result)
+        {
+            sLog.outError("[ERROR] user %s tried to login and we cannot find his session key in the database.", _login.c_str());
+            Close();
+            return;
+        }
 
-    ///- All good, await client's proof
-    _status = STATUS_RECON_PROOF;
+        Field* fields = result->Fetch();
+        srp.SetStrongSessionKey(fields[0].GetString());
+
+        ///- All good, await client's proof
+        _status = STATUS_RECON_PROOF;
+
+        ///- Sending response
+        ByteBuffer pkt;
+        pkt << (uint8)  CMD_AUTH_RECONNECT_CHALLENGE;
+        pkt << (uint8)  0x00;
+        _reconnectProof.SetRand(16 * 8);
+        pkt.append(_reconnectProof.AsByteArray(16));        // 16 bytes random
+        pkt.append(VersionChallenge.data(), VersionChallenge.size());
+        Write((const char*)pkt.contents(), pkt.size());
+    });
 
-    ///- Sending response
-    ByteBuffer pkt;
-    pkt << (uint8)  CMD_AUTH_RECONNECT_CHALLENGE;
-    pkt << (uint8)  0x00;
-    _reconnectProof.SetRand(16 * 8);
-    pkt.append(_reconnectProof.AsByteArray(16));        // 16 bytes random
-    pkt.append(VersionChallenge.data(), VersionChallenge.size());
-    Write((const char*)pkt.contents(), pkt.size());
     return true;
 }
 
@@ -800,182 +876,77 @@ bool AuthSocket::_HandleRealmList()
 
     ReadSkip(5);
 
-    ///- Get the user id (else close the connection)
-    // No SQL injection (escaped user name)
-
-    QueryResult* result = LoginDatabase.PQuery("SELECT id, gmlevel FROM account WHERE username = '%s'", _safelogin.c_str());
-    if (!result)
+    if (m_realmListQueried)
     {
-        sLog.outError("[ERROR] user %s tried to login and we cannot find him in the database.", _login.c_str());
-        Close();
-        return false;
+        SendRealmList();
+        return true;
     }
 
-    uint32 id = (*result)[0].GetUInt32();
-    uint8 accountSecurityLevel = (*result)[1].GetUInt8();
-    delete result;
-
-    ///- Update realm list if need
-    sRealmList.UpdateIfNeed();
-
-    ///- Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
-    ByteBuffer pkt;
-    LoadRealmlist(pkt, id, accountSecurityLevel);
-
-    ByteBuffer hdr;
-    hdr << (uint8) CMD_REALM_LIST;
-    hdr << (uint16)pkt.size();
-    hdr.append(pkt);
-
-    Write((const char*)hdr.contents(), hdr.size());
-    return true;
-}
-
-void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 securityLevel)
-{
-    switch (_build)
+    struct RealmListQuery
     {
-        case 5875:                                          // 1.12.1
-        case 6005:                                          // 1.12.2
-        case 6141:                                          // 1.12.3
-        {
-            pkt << uint32(0);                               // unused value
-            pkt << uint8(getEligibleRealmCount(securityLevel));
-
-            for (const auto& i : sRealmList)
-            {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult* result = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (result)
-                {
-                    Field* fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                    delete result;
-                }
-                else
-                    AmountOfCharacters = 0;
-
-                bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
-
-                RealmBuildInfo const* buildInfo = ok_build ? FindBuildInfo(_build) : nullptr;
-                if (!buildInfo)
-                    buildInfo = &i.second.realmBuildInfo;
+        bool found = false;
+        uint8 accountSecurityLevel = 0;
+        RealmCharacterCounts characterCounts;
+    };
 
-                RealmFlags realmflags = i.second.realmflags;
+    std::shared_ptr<RealmListQuery> query = std::make_shared<RealmListQuery>();
+    std::string safelogin = _safelogin;
+    RunDBQuery([query, safelogin]()
+    {
+        ///- Get the user id (else close the connection)
+        // No SQL injection (escaped user name)
+        std::unique_ptr<QueryResult> result(LoginDatabase.PQuery("SELECT id, gmlevel FROM account WHERE username = '%s'", safelogin.c_str()));
+        if (!result)
+            return;
 
-                // Don't display higher security realms for players.
-                if (!securityLevel && i.second.allowedSecurityLevel > 0)
-                    continue;
+        query->found = true;
+        uint32 id = (*result)[0].GetUInt32();
+        query->accountSecurityLevel = (*result)[1].GetUInt8();
 
-                // 1.x clients not support explicitly REALM_FLAG_SPECIFYBUILD, so manually form similar name as show in more recent clients
-                std::string name = i.first;
-                if (realmflags & REALM_FLAG_SPECIFYBUILD)
-                {
-                    char buf[20];
-                    snprintf(buf, 20, " (%u,%u,%u)", buildInfo->major_version, buildInfo->minor_version, buildInfo->bugfix_version);
-                    name += buf;
-                }
-
-                // Show offline state for unsupported client builds and locked realms (1.x clients not support locked state show)
-                if (!ok_build || (i.second.allowedSecurityLevel > _accountSecurityLevel))
-                    realmflags = RealmFlags(realmflags | REALM_FLAG_OFFLINE);
-
-                pkt << uint32(i.second.icon);              // realm type
-                pkt << uint8(realmflags);                   // realmflags
-                pkt << name;                                // name
-                pkt << i.second.address;                   // address
-                pkt << float(i.second.populationLevel);
-                pkt << uint8(AmountOfCharacters);
-                pkt << uint8(i.second.timezone);           // realm category
-                pkt << uint8(0x00);                         // unk, may be realm number/id?
-            }
+        ///- Character counts of all realms at once
+        std::unique_ptr<QueryResult> counts(LoginDatabase.PQuery("SELECT realmid, numchars FROM realmcharacters WHERE acctid = '%u'", id));
+        if (!counts)
+            return;
 
-            pkt << uint16(0x0002);                          // unused value (why 2?)
-            break;
+        do
+        {
+            Field* fields = counts->Fetch();
+            query->characterCounts[fields[0].GetUInt32()] = fields[1].GetUInt8();
         }
-
-        case 8606:                                          // 2.4.3
-        case 10505:                                         // 3.2.2a
-        case 11159:                                         // 3.3.0a
-        case 11403:                                         // 3.3.2
-        case 11723:                                         // 3.3.3a
-        case 12340:                                         // 3.3.5a
-        default:                                            // and later
+        while (counts->NextRow());
+    }, [this, query]()
+    {
+        if (!query->found)
         {
-            pkt << uint32(0);                               // unused value
-            pkt << uint16(getEligibleRealmCount(securityLevel));
-
-            for (const auto& i : sRealmList)
-            {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult* result = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (result)
-                {
-                    Field* fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                    delete result;
-                }
-                else
-                    AmountOfCharacters = 0;
-
-                bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
-
-                RealmBuildInfo const* buildInfo = ok_build ? FindBuildInfo(_build) : nullptr;
-                if (!buildInfo)
-                    buildInfo = &i.second.realmBuildInfo;
-
-                // Don't display higher security realms for players.
-                if (!securityLevel && i.second.allowedSecurityLevel > 0)
-                    continue;
-
-                uint8 lock = (i.second.allowedSecurityLevel > _accountSecurityLevel) ? 1 : 0;
-
-                RealmFlags realmFlags = i.second.realmflags;
-
-                // Show offline state for unsupported client builds
-                if (!ok_build)
-                    realmFlags = RealmFlags(realmFlags | REALM_FLAG_OFFLINE);
-
-                if (!buildInfo)
-                    realmFlags = RealmFlags(realmFlags & ~REALM_FLAG_SPECIFYBUILD);
+            sLog.outError("[ERROR] user %s tried to login and we cannot find him in the database.", _login.c_str());
+            Close();
+            return;
+        }
 
-                pkt << uint8(i.second.icon);               // realm type (this is second column in Cfg_Configs.dbc)
-                pkt << uint8(lock);                         // flags, if 0x01, then realm locked
-                pkt << uint8(realmFlags);                   // see enum RealmFlags
-                pkt << i.first;                            // name
-                pkt << i.second.address;                   // address
-                pkt << float(i.second.populationLevel);
-                pkt << uint8(AmountOfCharacters);
-                pkt << uint8(i.second.timezone);           // realm category (Cfg_Categories.dbc)
-                pkt << uint8(0x2C);                         // unk, may be realm number/id?
+        ///- Character counts only change in a world session, after which the client logs on anew with a new connection
+        m_realmListQueried = true;
+        m_realmListSecurityLevel = query->accountSecurityLevel;
+        m_realmCharacterCounts.swap(query->characterCounts);
 
-                if (realmFlags & REALM_FLAG_SPECIFYBUILD)
-                {
-                    pkt << uint8(buildInfo->major_version);
-                    pkt << uint8(buildInfo->minor_version);
-                    pkt << uint8(buildInfo->bugfix_version);
-                    pkt << uint16(_build);
-                }
-            }
+        _status = STATUS_AUTHED;
+        SendRealmList();
+    });
 
-            pkt << uint16(0x0010);                          // unused value (why 10?)
-            break;
-        }
-    }
+    return true;
 }
 
-uint8 AuthSocket::getEligibleRealmCount(uint8 accountSecurityLevel)
+void AuthSocket::SendRealmList()
 {
-    uint8 size = 0;
-    for (const auto& i : sRealmList)
-        if (i.second.allowedSecurityLevel <= accountSecurityLevel)
-            size++;
+    ///- Copy the prepared realm list of the client build and add the character counts of the account
+    ByteBuffer pkt;
+    sRealmList.LoadRealmlist(pkt, _build, m_realmCharacterCounts, m_realmListSecurityLevel, _accountSecurityLevel);
 
-    return size;
+    ByteBuffer hdr;
+    hdr << (uint8) CMD_REALM_LIST;
+    hdr << (uint16)pkt.size();
+    hdr.append(pkt);
+
+    Write((const char*)hdr.contents(), hdr.size());
 }
 
 /// Resume patch transfer
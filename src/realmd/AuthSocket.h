@@ -28,15 +28,19 @@
 #include "Auth/CryptoHash.h"
 #include "Auth/SRP6.h"
 #include "Util/ByteBuffer.h"
+#include "RealmList.h"
 
 #include "Network/Socket.hpp"
 
 #include <boost/asio.hpp>
 
 #include <functional>
+#include <memory>
 
 #define HMAC_RES_SIZE 20
 
+class QueryResult;
+
 class AuthSocket : public MaNGOS::Socket
 {
     public:
@@ -47,11 +51,8 @@ class AuthSocket : public MaNGOS::Socket
         bool Open() override;
 
         void SendProof(Sha1Hash sha);
-        void LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 accountSecurityLevel = 0);
         int32 generateToken(char const* b32key);
 
-        uint8 getEligibleRealmCount(uint8 accountSecurityLevel);
-
         bool VerifyVersion(uint8 const* a, int32 aLength, uint8 const* versionProof, bool isReconnect);
         bool _HandleLogonChallenge();
         bool _HandleLogonProof();
@@ -72,9 +73,25 @@ class AuthSocket : public MaNGOS::Socket
             STATUS_RECON_PROOF,
             STATUS_PATCH,      // unused in CMaNGOS
             STATUS_AUTHED,
+            STATUS_WAIT_DB,    // command processing suspended until the login database answered
             STATUS_CLOSED
         };
 
+        /// Login database answers for a logon challenge, collected on the query pool
+        struct LogonChallengeQuery
+        {
+            bool ipBanned = false;
+            std::unique_ptr<QueryResult> account;
+            std::unique_ptr<QueryResult> accountBan;
+        };
+
+        void _HandleLogonChallengeResult(LogonChallengeQuery const& query);
+        void SendRealmList();
+
+        /// Runs query on the query pool and resume afterwards on the network thread of this socket, unless it got closed meanwhile
+        void RunDBQuery(std::function<void()> query, std::function<void()> resume);
+        void ProcessPendingData();
+
         SRP6 srp;
         BigNumber _reconnectProof;
 
@@ -88,8 +105,15 @@ class AuthSocket : public MaNGOS::Socket
         std::string m_locale;
         std::string _safelocale;
         uint16 _build;
+        uint32 _accountId;
         AccountTypes _accountSecurityLevel;
 
+        // account data of the realm list, queried once per connection, clients repeat the request while the list is open
+        bool m_realmListQueried;
+        uint8 m_realmListSecurityLevel;
+        RealmCharacterCounts m_realmCharacterCounts;
+
+        boost::asio::io_service& m_service;
         boost::asio::deadline_timer m_timeoutTimer;
 
         virtual bool ProcessIncomingData() override;
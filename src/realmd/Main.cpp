@@ -27,6 +27,7 @@
 #include "Config/Config.h"
 #include "Log.h"
 #include "AuthSocket.h"
+#include "AuthQueryPool.h"
 #include "SystemConfig.h"
 #include "revision.h"
 #include "revision_sql.h"
@@ -232,6 +233,9 @@ int main(int argc, char* argv[])
     LoginDatabase.Execute("DELETE FROM ip_banned WHERE expires_at<=UNIX_TIMESTAMP() AND expires_at<>banned_at");
     LoginDatabase.CommitTransaction();
 
+    ///- Start the workers for the login queries of the auth sockets
+    sAuthQueryPool.Start(std::max(sConfig.GetIntDefault("LoginDatabase.WorkerThreads", 2), 0));
+
     // FIXME - more intelligent selection of thread count is needed here.  config option?
     MaNGOS::Listener<AuthSocket> listener(
             sConfig.GetStringDefault("BindIP", "0.0.0.0"),
@@ -304,6 +308,10 @@ int main(int argc, char* argv[])
             DETAIL_LOG("Ping MySQL to keep connection alive");
             LoginDatabase.Ping();
         }
+
+        ///- Reload the realms here, the network threads only copy prepared realm list packets
+        sRealmList.UpdateIfNeed();
+
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
 #ifdef _WIN32
         if (m_ServiceStatus == 0) stopEvent = true;
@@ -311,6 +319,9 @@ int main(int argc, char* argv[])
 #endif
     }
 
+    ///- Let the query workers finish before the delay thread stops
+    sAuthQueryPool.Stop();
+
     ///- Wait for the delay thread to exit
     LoginDatabase.HaltDelayThread();
 
@@ -351,9 +362,12 @@ bool StartDB()
         return false;
     }
 
-    sLog.outString("Login Database total connections: %i", 1 + 1);
+    // one query connection per query pool worker, so the workers do not wait for each other
+    int nConnections = std::max(sConfig.GetIntDefault("LoginDatabase.WorkerThreads", 2), 1);
+
+    sLog.outString("Login Database total connections: %i", nConnections + 1);
 
-    if (!LoginDatabase.Initialize(dbstring.c_str()))
+    if (!LoginDatabase.Initialize(dbstring.c_str(), nConnections))
     {
         sLog.outError("Cannot connect to database");
         return false;
@@ -81,7 +81,7 @@ RealmBuildInfo const* FindBuildInfo(uint16 _build)
     return nullptr;
 }
 
-RealmList::RealmList() : m_UpdateInterval(0), m_NextUpdateTime(time(nullptr))
+RealmList::RealmList() : m_realms(std::make_shared<RealmMap>()), m_UpdateInterval(0), m_NextUpdateTime(time(nullptr))
 {
 }
 
@@ -97,13 +97,24 @@ void RealmList::Initialize(uint32 updateInterval)
     m_UpdateInterval = updateInterval;
 
     ///- Get the content of the realmlist table in the database
-    UpdateRealms(true);
+    std::shared_ptr<RealmMap> realms = std::make_shared<RealmMap>();
+    UpdateRealms(*realms, true);
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_realms = realms;
+    m_packets.clear();
+}
+
+uint32 RealmList::size() const
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_realms->size();
 }
 
-void RealmList::UpdateRealm(uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds)
+void RealmList::UpdateRealm(RealmMap& realms, uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds)
 {
     ///- Create new if not exist or update existed
-    Realm& realm = m_realms[name];
+    Realm& realm = realms[name];
 
     realm.m_ID       = ID;
     realm.icon       = icon;
@@ -147,14 +158,17 @@ void RealmList::UpdateIfNeed()
 
     m_NextUpdateTime = time(nullptr) + m_UpdateInterval;
 
-    // Clears Realm list
-    m_realms.clear();
-
     // Get the content of the realmlist table in the database
-    UpdateRealms(false);
+    std::shared_ptr<RealmMap> realms = std::make_shared<RealmMap>();
+    UpdateRealms(*realms, false);
+
+    // sockets keep serving the previous realms until the new ones are complete, prepared packets are rebuilt on demand
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_realms = realms;
+    m_packets.clear();
 }
 
-void RealmList::UpdateRealms(bool init)
+void RealmList::UpdateRealms(RealmMap& realms, bool init)
 {
     DETAIL_LOG("Updating Realm List...");
 
@@ -179,7 +193,7 @@ void RealmList::UpdateRealms(bool init)
                 realmflags &= (REALM_FLAG_OFFLINE | REALM_FLAG_NEW_PLAYERS | REALM_FLAG_RECOMMENDED | REALM_FLAG_SPECIFYBUILD);
             }
 
-            UpdateRealm(
+            UpdateRealm(realms,
                 Id, name, fields[2].GetCppString(), fields[3].GetUInt32(),
                 fields[4].GetUInt8(), RealmFlags(realmflags), fields[6].GetUInt8(),
                 (allowedSecurityLevel <= SEC_ADMINISTRATOR ? AccountTypes(allowedSecurityLevel) : SEC_ADMINISTRATOR),
@@ -192,3 +206,159 @@ void RealmList::UpdateRealms(bool init)
         delete result;
     }
 }
+
+void RealmList::LoadRealmlist(ByteBuffer& pkt, uint16 build, RealmCharacterCounts const& characterCounts, uint8 securityLevel, AccountTypes accountSecurityLevel)
+{
+    std::shared_ptr<RealmListPacket const> packet = GetRealmListPacket(build, securityLevel, accountSecurityLevel);
+
+    ///- Copy the prepared packet and fill in the character counts of the account
+    size_t start = pkt.wpos();
+    pkt.append(packet->data);
+    for (auto const& slot : packet->characterCountSlots)
+    {
+        RealmCharacterCounts::const_iterator count = characterCounts.find(slot.second);
+        if (count != characterCounts.end())
+            pkt.put<uint8>(start + slot.first, count->second);
+    }
+}
+
+std::shared_ptr<RealmListPacket const> RealmList::GetRealmListPacket(uint16 build, uint8 securityLevel, AccountTypes accountSecurityLevel)
+{
+    uint32 key = (uint32(build) << 16) | (uint32(securityLevel) << 8) | uint32(accountSecurityLevel);
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    auto itr = m_packets.find(key);
+    if (itr != m_packets.end())
+        return itr->second;
+
+    std::shared_ptr<RealmListPacket> packet = std::make_shared<RealmListPacket>();
+    BuildRealmListPacket(*packet, *m_realms, build, securityLevel, accountSecurityLevel);
+    m_packets[key] = packet;
+    return packet;
+}
+
+void RealmList::BuildRealmListPacket(RealmListPacket& packet, RealmMap const& realms, uint16 build, uint8 securityLevel, AccountTypes accountSecurityLevel)
+{
+    ByteBuffer& pkt = packet.data;
+
+    switch (build)
+    {
+        case 5875:                                          // 1.12.1
+        case 6005:                                          // 1.12.2
+        case 6141:                                          // 1.12.3
+        {
+            pkt << uint32(0);                               // unused value
+            pkt << uint8(GetEligibleRealmCount(realms, securityLevel));
+
+            for (const auto& i : realms)
+            {
+                bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), build) != i.second.realmbuilds.end();
+
+                RealmBuildInfo const* buildInfo = ok_build ? FindBuildInfo(build) : nullptr;
+                if (!buildInfo)
+                    buildInfo = &i.second.realmBuildInfo;
+
+                RealmFlags realmflags = i.second.realmflags;
+
+                // Don't display higher security realms for players.
+                if (!securityLevel && i.second.allowedSecurityLevel > 0)
+                    continue;
+
+                // 1.x clients not support explicitly REALM_FLAG_SPECIFYBUILD, so manually form similar name as show in more recent clients
+                std::string name = i.first;
+                if (realmflags & REALM_FLAG_SPECIFYBUILD)
+                {
+                    char buf[20];
+                    snprintf(buf, 20, " (%u,%u,%u)", buildInfo->major_version, buildInfo->minor_version, buildInfo->bugfix_version);
+                    name += buf;
+                }
+
+                // Show offline state for unsupported client builds and locked realms (1.x clients not support locked state show)
+                if (!ok_build || (i.second.allowedSecurityLevel > accountSecurityLevel))
+                    realmflags = RealmFlags(realmflags | REALM_FLAG_OFFLINE);
+
+                pkt << uint32(i.second.icon);              // realm type
+                pkt << uint8(realmflags);                   // realmflags
+                pkt << name;                                // name
+                pkt << i.second.address;                   // address
+                pkt << float(i.second.populationLevel);
+                packet.characterCountSlots.emplace_back(pkt.wpos(), i.second.m_ID);
+                pkt << uint8(0);                            // characters of the account, set per request
+                pkt << uint8(i.second.timezone);           // realm category
+                pkt << uint8(0x00);                         // unk, may be realm number/id?
+            }
+
+            pkt << uint16(0x0002);                          // unused value (why 2?)
+            break;
+        }
+
+        case 8606:                                          // 2.4.3
+        case 10505:                                         // 3.2.2a
+        case 11159:                                         // 3.3.0a
+        case 11403:                                         // 3.3.2
+        case 11723:                                         // 3.3.3a
+        case 12340:                                         // 3.3.5a
+        default:                                            // and later
+        {
+            pkt << uint32(0);                               // unused value
+            pkt << uint16(GetEligibleRealmCount(realms, securityLevel));
+
+            for (const auto& i : realms)
+            {
+                bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), build) != i.second.realmbuilds.end();
+
+                RealmBuildInfo const* buildInfo = ok_build ? FindBuildInfo(build) : nullptr;
+                if (!buildInfo)
+                    buildInfo = &i.second.realmBuildInfo;
+
+                // Don't display higher security realms for players.
+                if (!securityLevel && i.second.allowedSecurityLevel > 0)
+                    continue;
+
+                uint8 lock = (i.second.allowedSecurityLevel > accountSecurityLevel) ? 1 : 0;
+
+                RealmFlags realmFlags = i.second.realmflags;
+
+                // Show offline state for unsupported client builds
+                if (!ok_build)
+                    realmFlags = RealmFlags(realmFlags | REALM_FLAG_OFFLINE);
+
+                if (!buildInfo)
+                    realmFlags = RealmFlags(realmFlags & ~REALM_FLAG_SPECIFYBUILD);
+
+                pkt << uint8(i.second.icon);               // realm type (this is second column in Cfg_Configs.dbc)
+                pkt << uint8(lock);                         // flags, if 0x01, then realm locked
+                pkt << uint8(realmFlags);                   // see enum RealmFlags
+                pkt << i.first;                            // name
+                pkt << i.second.address;                   // address
+                pkt << float(i.second.populationLevel);
+                packet.characterCountSlots.emplace_back(pkt.wpos(), i.second.m_ID);
+                pkt << uint8(0);                            // characters of the account, set per request
+                pkt << uint8(i.second.timezone);           // realm category (Cfg_Categories.dbc)
+                pkt << uint8(0x2C);                         // unk, may be realm number/id?
+
+                if (realmFlags & REALM_FLAG_SPECIFYBUILD)
+                {
+                    pkt << uint8(buildInfo->major_version);
+                    pkt << uint8(buildInfo->minor_version);
+                    pkt << uint8(buildInfo->bugfix_version);
+                    pkt << uint16(build);
+                }
+            }
+
+            pkt << uint16(0x0010);                          // unused value (why 10?)
+            break;
+        }
+    }
+}
+
+uint8 RealmList::GetEligibleRealmCount(RealmMap const& realms, uint8 accountSecurityLevel)
+{
+    uint8 size = 0;
+    for (const auto& i : realms)
+        if (i.second.allowedSecurityLevel <= accountSecurityLevel)
+            size++;
+
+    return size;
+}
@@ -24,7 +24,12 @@
 #define _REALMLIST_H
 
 #include "Common.h"
+#include "Util/ByteBuffer.h"
+
 #include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 struct RealmBuildInfo
 {
@@ -55,6 +60,16 @@ struct Realm
     RealmBuildInfo realmBuildInfo;                          // build info for show version in list
 };
 
+/// Realm list packet body prepared for one client build and security level, shared by all accounts
+struct RealmListPacket
+{
+    ByteBuffer data;
+    std::vector<std::pair<size_t, uint32>> characterCountSlots;    // (position in data, realm id) of the per account character counts
+};
+
+/// Number of characters of an account per realm id
+typedef std::map<uint32, uint8> RealmCharacterCounts;
+
 /// Storage object for the list of realms on the server
 class RealmList
 {
@@ -68,18 +83,28 @@ class RealmList
 
         void Initialize(uint32 updateInterval);
 
+        // reloads the realms from the database when the update delay expired, called from the main thread only
         void UpdateIfNeed();
 
-        RealmMap::const_iterator begin() const { return m_realms.begin(); }
-        RealmMap::const_iterator end() const { return m_realms.end(); }
-        uint32 size() const { return m_realms.size(); }
+        // writes the realm list packet body for the client build into pkt, any thread
+        void LoadRealmlist(ByteBuffer& pkt, uint16 build, RealmCharacterCounts const& characterCounts, uint8 securityLevel, AccountTypes accountSecurityLevel);
+
+        uint32 size() const;
     private:
-        void UpdateRealms(bool init);
-        void UpdateRealm(uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds);
+        std::shared_ptr<RealmListPacket const> GetRealmListPacket(uint16 build, uint8 securityLevel, AccountTypes accountSecurityLevel);
+        static void BuildRealmListPacket(RealmListPacket& packet, RealmMap const& realms, uint16 build, uint8 securityLevel, AccountTypes accountSecurityLevel);
+        static uint8 GetEligibleRealmCount(RealmMap const& realms, uint8 accountSecurityLevel);
+
+        void UpdateRealms(RealmMap& realms, bool init);
+        void UpdateRealm(RealmMap& realms, uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds);
     private:
-        RealmMap m_realms;                                  ///< Internal map of realms
+        std::shared_ptr<RealmMap const> m_realms;           ///< Internal map of realms, replaced as a whole at update
         uint32   m_UpdateInterval;
         time_t   m_NextUpdateTime;
+
+        // prepared packets of the current realms, by build, security level and account security level
+        std::map<uint32, std::shared_ptr<RealmListPacket const>> m_packets;
+        mutable std::mutex m_lock;
 };
 
 #define sRealmList RealmList::Instance()
@@ -22,6 +22,26 @@
 
 #include "DBCFileLoader.h"
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+// Private (copy on write) mapping, so the file is never modified and not read into the heap.
+// The pages are shared with the file cache until somebody writes to them.
+class DBCFileMapping
+{
+    public:
+        explicit DBCFileMapping(const char* filename) :
+            m_region(boost::interprocess::file_mapping(filename, boost::interprocess::read_only), boost::interprocess::copy_on_write)
+        {
+        }
+
+        unsigned char* GetData() const { return static_cast<unsigned char*>(m_region.get_address()); }
+        size_t GetSize() const { return m_region.get_size(); }
+
+    private:
+        boost::interprocess::mapped_region m_region;
+};
+
 DBCFileLoader::DBCFileLoader()
 {
     data = nullptr;
@@ -30,60 +50,46 @@ DBCFileLoader::DBCFileLoader()
 
 bool DBCFileLoader::Load(const char* filename, const char* fmt)
 {
-    uint32 header;
-    delete[] data;
-
-    FILE* f = fopen(filename, "rb");
-    if (!f)
-        return false;
+    data = nullptr;
+    m_file.reset();
 
-    if (fread(&header, 4, 1, f) != 1)                       // Number of records
+    try
     {
-        fclose(f);
-        return false;
+        m_file = std::make_shared<DBCFileMapping>(filename);
+    }
+    catch (boost::interprocess::interprocess_exception const&)
+    {
+        return false;                                       // missing or empty file
     }
 
+    unsigned char const* file = m_file->GetData();
+    size_t const headerSize = 5 * 4;
+    if (m_file->GetSize() < headerSize)
+        return false;
 
+    uint32 header;
+    memcpy(&header, file, 4);
     EndianConvert(header);
 
     if (header != 0x43424457)                               //'WDBC'
-    {
-        fclose(f);
         return false;
-    }
-
-    if (fread(&recordCount, 4, 1, f) != 1)                  // Number of records
-    {
-        fclose(f);
-        return false;
-    }
 
+    memcpy(&recordCount, file + 4, 4);                      // Number of records
     EndianConvert(recordCount);
 
-    if (fread(&fieldCount, 4, 1, f) != 1)                   // Number of fields
-    {
-        fclose(f);
-        return false;
-    }
-
+    memcpy(&fieldCount, file + 8, 4);                       // Number of fields
     EndianConvert(fieldCount);
 
-    if (fread(&recordSize, 4, 1, f) != 1)                   // Size of a record
-    {
-        fclose(f);
-        return false;
-    }
-
+    memcpy(&recordSize, file + 12, 4);                      // Size of a record
     EndianConvert(recordSize);
 
-    if (fread(&stringSize, 4, 1, f) != 1)                   // String size
-    {
-        fclose(f);
-        return false;
-    }
-
+    memcpy(&stringSize, file + 16, 4);                      // String size
     EndianConvert(stringSize);
 
+    if (!fieldCount || m_file->GetSize() < headerSize + size_t(recordSize) * recordCount + stringSize)
+        return false;
+
+    delete[] fieldsOffset;
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
     for (uint32 i = 1; i < fieldCount; ++i)
@@ -95,22 +101,13 @@ bool DBCFileLoader::Load(const char* filename, const char* fmt)
             fieldsOffset[i] += 4;
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
+    data = m_file->GetData() + headerSize;
     stringTable = data + recordSize * recordCount;
-
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-    {
-        fclose(f);
-        return false;
-    }
-
-    fclose(f);
     return true;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    delete[] data;
     delete[] fieldsOffset;
 }
 
@@ -259,14 +256,11 @@ char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**
     return dataTable;
 }
 
-char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
+std::shared_ptr<DBCFileMapping> DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
 {
     if (strlen(format) != fieldCount)
         return nullptr;
 
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
-
     uint32 offset = 0;
 
     for (uint32 y = 0; y < recordCount; ++y)
@@ -290,10 +284,7 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
                     // fill only not filled entries
                     char** slot = (char**)(&dataTable[offset]);
                     if (!*slot || !** slot)
-                    {
-                        const char* st = getRecord(y).getString(x);
-                        *slot = stringPool + (st - (const char*)stringTable);
-                    }
+                        *slot = const_cast<char*>(getRecord(y).getString(x));
                     offset += sizeof(char*);
                     break;
                 }
@@ -311,5 +302,5 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
         }
     }
 
-    return stringPool;
+    return m_file;
 }
@@ -21,6 +21,8 @@
 #include "Platform/Define.h"
 #include "Util/ByteConverter.h"
 #include <cassert>
+#include <memory>
+#include <string>
 
 enum FieldFormat
 {
@@ -38,6 +40,9 @@ enum FieldFormat
     FT_64BITINT = 'L'                                       // uint64
 };
 
+// memory mapped content of a .dbc file, see DBCFileLoader.cpp
+class DBCFileMapping;
+
 class DBCFileLoader
 {
     public:
@@ -94,7 +99,8 @@ class DBCFileLoader
         uint32 GetOffset(size_t id) const { return (fieldsOffset != nullptr && id < fieldCount) ? fieldsOffset[id] : 0; }
         bool IsLoaded() const { return data != nullptr; }
         char* AutoProduceData(const char* format, uint32& records, char**& indexTable);
-        char* AutoProduceStrings(const char* format, char* dataTable);
+        // string fields point into the mapped file, which stays mapped as long as the returned pointer is held
+        std::shared_ptr<DBCFileMapping> AutoProduceStrings(const char* format, char* dataTable);
         static uint32 GetFormatRecordSize(const char* format, int32* index_pos = nullptr);
     private:
 
@@ -105,5 +111,6 @@ class DBCFileLoader
         uint32* fieldsOffset;
         unsigned char* data;
         unsigned char* stringTable;
+        std::shared_ptr<DBCFileMapping> m_file;
 };
 #endif
@@ -24,7 +24,7 @@
 template<class T>
 class DBCStorage
 {
-        typedef std::list<char*> StringPoolList;
+        typedef std::list<std::shared_ptr<DBCFileMapping>> StringPoolList;
     public:
         explicit DBCStorage(const char* f) : nCount(0), fieldCount(0), fmt(f), indexTable(nullptr), m_dataTable(nullptr) { }
         ~DBCStorage() { Clear(); }
@@ -80,11 +80,7 @@ class DBCStorage
             delete[]((char*)m_dataTable);
             m_dataTable = nullptr;
 
-            while (!m_stringPoolList.empty())
-            {
-                delete[] m_stringPoolList.front();
-                m_stringPoolList.pop_front();
-            }
+            m_stringPoolList.clear();
             nCount = 0;
         }
 
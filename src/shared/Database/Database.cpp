@@ -412,6 +412,12 @@ bool Database::CommitTransaction()
     return true;
 }
 
+uint32 Database::GetTransactionSize() const
+{
+    SqlTransaction const* pTrans = m_currentTransaction.get();
+    return pTrans ? uint32(pTrans->GetSize()) : 0;
+}
+
 bool Database::CommitTransactionDirect()
 {
     if (!m_pAsyncConn)
@@ -188,6 +188,8 @@ class Database
         bool RollbackTransaction();
         // for sync transaction execution
         bool CommitTransactionDirect();
+        // number of statements queued so far in this thread's open transaction
+        uint32 GetTransactionSize() const;
 
         // PREPARED STATEMENT API
 
@@ -17,6 +17,10 @@
  */
 
 #include "SQLStorage.h"
+#include "Log.h"
+
+#include <cstdio>
+#include <fstream>
 
 // -----------------------------------  SQLStorageBase  ---------------------------------------- //
 
@@ -65,6 +69,256 @@ void SQLStorageBase::prepareToLoad(uint32 maxEntry, uint32 recordCount, uint32 r
     m_recordCount = 0;
 }
 
+uint32 SQLStorageBase::CalculateRecordSize() const
+{
+    uint32 recordSize = 0;
+    for (uint32 x = 0; x < m_dstFieldCount; ++x)
+    {
+        switch (m_dst_format[x])
+        {
+            case FT_LOGIC:
+                recordSize += sizeof(bool);   break;
+            case FT_BYTE:
+                recordSize += sizeof(char);   break;
+            case FT_INT:
+                recordSize += sizeof(uint32); break;
+            case FT_FLOAT:
+                recordSize += sizeof(float);  break;
+            case FT_STRING:
+                recordSize += sizeof(char*);  break;
+            case FT_NA:
+                recordSize += sizeof(uint32); break;
+            case FT_NA_BYTE:
+                recordSize += sizeof(char);   break;
+            case FT_NA_FLOAT:
+                recordSize += sizeof(float);  break;
+            case FT_NA_POINTER:
+                recordSize += sizeof(char*);  break;
+            case FT_64BITINT:
+                recordSize += sizeof(uint64);  break;
+            case FT_IND:
+            case FT_SORT:
+                assert(false && "SQL storage not have sort field types");
+                break;
+            default:
+                assert(false && "unknown format character");
+                break;
+        }
+    }
+    return recordSize;
+}
+
+// -----------------------------------  Snapshots  --------------------------------------------- //
+
+std::string SQLStorageBase::m_snapshotDir;
+
+namespace
+{
+    uint32 const SNAPSHOT_MAGIC   = 0x50414E53;             // 'SNAP'
+    uint32 const SNAPSHOT_VERSION = 1;
+
+    struct SnapshotHeader
+    {
+        uint32 magic;
+        uint32 version;
+        uint64 formatHash;
+        uint64 tableChecksum;
+        uint32 maxEntry;
+        uint32 recordCount;
+        uint32 recordSize;
+        uint32 stringPoolSize;
+    };
+
+    // FNV-1a
+    void HashBytes(uint64& hash, void const* data, size_t size)
+    {
+        unsigned char const* bytes = static_cast<unsigned char const*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= uint64(0x100000001B3);
+        }
+    }
+}
+
+// string fields are stored as offsets into the string pool of the snapshot
+void SQLStorageBase::GetStringFieldOffsets(std::vector<uint32>& offsets) const
+{
+    uint32 offset = 0;
+    for (uint32 x = 0; x < m_dstFieldCount; ++x)
+    {
+        switch (m_dst_format[x])
+        {
+            case FT_LOGIC:      offset += sizeof(bool);   break;
+            case FT_BYTE:
+            case FT_NA_BYTE:    offset += sizeof(char);   break;
+            case FT_INT:
+            case FT_NA:         offset += sizeof(uint32); break;
+            case FT_FLOAT:
+            case FT_NA_FLOAT:   offset += sizeof(float);  break;
+            case FT_64BITINT:   offset += sizeof(uint64); break;
+            case FT_STRING:
+            case FT_NA_POINTER:
+                offsets.push_back(offset);
+                offset += sizeof(char*);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+// snapshots are raw records, so they are only valid for the same formats on the same architecture
+uint64 SQLStorageBase::GetSnapshotFormatHash() const
+{
+    uint64 hash = uint64(0xCBF29CE484222325);
+    HashBytes(hash, m_entry_field, strlen(m_entry_field) + 1);
+    HashBytes(hash, m_src_format, m_srcFieldCount + 1);
+    HashBytes(hash, m_dst_format, m_dstFieldCount + 1);
+
+    uint32 layout[] = { CalculateRecordSize(), uint32(sizeof(char*)), 0x01020304 };
+    HashBytes(hash, layout, sizeof(layout));
+    return hash;
+}
+
+std::string SQLStorageBase::GetSnapshotFileName() const
+{
+    return m_snapshotDir + m_tableName + ".snapshot";
+}
+
+bool SQLStorageBase::LoadSnapshot(uint64 tableChecksum)
+{
+    std::ifstream file(GetSnapshotFileName().c_str(), std::ios::binary);
+    if (!file)
+        return false;
+
+    uint32 recordSize = CalculateRecordSize();
+
+    SnapshotHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        return false;
+
+    if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION || header.tableChecksum != tableChecksum ||
+            header.formatHash != GetSnapshotFormatHash() || header.recordSize != recordSize)
+        return false;
+
+    std::vector<uint32> recordIds(header.recordCount);
+    std::vector<char> records(size_t(header.recordCount) * recordSize);
+    std::vector<char> strings(header.stringPoolSize);
+    if (!file.read(reinterpret_cast<char*>(recordIds.data()), recordIds.size() * sizeof(uint32)) ||
+            !file.read(records.data(), records.size()) ||
+            !file.read(strings.data(), strings.size()))
+        return false;
+
+    std::vector<uint32> stringOffsets;
+    GetStringFieldOffsets(stringOffsets);
+
+    // check everything before the current data is dropped, a broken file only costs the normal load
+    if (!strings.empty() && strings.back() != '\0')
+        return false;
+
+    for (uint32 i = 0; i < header.recordCount; ++i)
+    {
+        if (recordIds[i] >= header.maxEntry)
+            return false;
+
+        for (uint32 offset : stringOffsets)
+        {
+            size_t pos;
+            memcpy(&pos, &records[size_t(i) * recordSize + offset], sizeof(pos));
+            if (pos >= strings.size())
+                return false;
+        }
+    }
+
+    prepareToLoad(header.maxEntry, header.recordCount, recordSize);
+
+    for (uint32 i = 0; i < header.recordCount; ++i)
+    {
+        char* record = createRecord(recordIds[i]);
+        memcpy(record, &records[size_t(i) * recordSize], recordSize);
+
+        for (uint32 offset : stringOffsets)
+        {
+            size_t pos;
+            memcpy(&pos, &record[offset], sizeof(pos));
+
+            uint32 l = strlen(&strings[pos]) + 1;
+            char* str = new char[l];
+            memcpy(str, &strings[pos], l);
+            memcpy(&record[offset], &str, sizeof(char*));
+        }
+    }
+
+    return true;
+}
+
+void SQLStorageBase::SaveSnapshot(uint64 tableChecksum, std::vector<uint32> const& recordIds) const
+{
+    MANGOS_ASSERT(recordIds.size() == m_recordCount);
+
+    std::vector<uint32> stringOffsets;
+    GetStringFieldOffsets(stringOffsets);
+
+    std::vector<char> records(m_data, m_data + size_t(m_recordCount) * m_recordSize);
+    std::string strings;
+    for (uint32 i = 0; i < m_recordCount; ++i)
+    {
+        char* record = &records[size_t(i) * m_recordSize];
+        for (uint32 offset : stringOffsets)
+        {
+            char const* str;
+            memcpy(&str, &record[offset], sizeof(char*));
+
+            size_t pos = strings.size();
+            strings.append(str ? str : "");
+            strings.push_back('\0');
+            memcpy(&record[offset], &pos, sizeof(pos));
+        }
+    }
+
+    SnapshotHeader header;
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.formatHash = GetSnapshotFormatHash();
+    header.tableChecksum = tableChecksum;
+    header.maxEntry = m_maxEntry;
+    header.recordCount = m_recordCount;
+    header.recordSize = m_recordSize;
+    header.stringPoolSize = uint32(strings.size());
+
+    // write to a temporary file first, a server stopped while writing must not leave a broken snapshot
+    std::string fileName = GetSnapshotFileName();
+    std::string tmpFileName = fileName + ".tmp";
+    {
+        std::ofstream file(tmpFileName.c_str(), std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            sLog.outError("Can't write table snapshot %s, check the TableSnapshotDir option", tmpFileName.c_str());
+            return;
+        }
+
+        file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        file.write(reinterpret_cast<char const*>(recordIds.data()), recordIds.size() * sizeof(uint32));
+        file.write(records.data(), records.size());
+        file.write(strings.data(), strings.size());
+        if (!file)
+        {
+            sLog.outError("Can't write table snapshot %s, check the TableSnapshotDir option", tmpFileName.c_str());
+            file.close();
+            std::remove(tmpFileName.c_str());
+            return;
+        }
+    }
+
+    std::remove(fileName.c_str());                          // rename does not replace existing files everywhere
+    if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+    {
+        sLog.outError("Can't rename table snapshot %s to %s", tmpFileName.c_str(), fileName.c_str());
+        std::remove(tmpFileName.c_str());
+    }
+}
+
 // Function to delete the data
 void SQLStorageBase::Free()
 {
@@ -39,6 +39,10 @@ class SQLStorageBase
         uint32 GetMaxEntry() const { return m_maxEntry; };
         uint32 GetRecordCount() const { return m_recordCount; };
 
+        // Directory for binary snapshots of loaded tables, empty disables them
+        static void SetSnapshotDir(std::string const& dir) { m_snapshotDir = dir; }
+        static bool IsSnapshotEnabled() { return !m_snapshotDir.empty(); }
+
         template<typename T>
         class SQLSIterator
         {
@@ -81,6 +85,17 @@ class SQLStorageBase
     private:
         char* createRecord(uint32 recordId);
 
+        // Binary snapshot of the records as loaded from the table, valid as long as
+        // the table checksum and the storage format match the ones stored in the file
+        uint32 CalculateRecordSize() const;
+        void GetStringFieldOffsets(std::vector<uint32>& offsets) const;
+        uint64 GetSnapshotFormatHash() const;
+        std::string GetSnapshotFileName() const;
+        bool LoadSnapshot(uint64 tableChecksum);
+        void SaveSnapshot(uint64 tableChecksum, std::vector<uint32> const& recordIds) const;
+
+        static std::string m_snapshotDir;
+
         // Information about the table
         const char* m_tableName;
         const char* m_entry_field;
@@ -248,6 +263,9 @@ template <class DerivedLoader, class StorageClass>
 class SQLStorageLoaderBase
 {
     public:
+        // records only depend on the table content, loaders with own convert functions may depend on more
+        static bool const CanUseSnapshot = false;
+
         void Load(StorageClass& store, bool error_at_empty = true);
 
         template<class S, class D>
@@ -280,14 +298,20 @@ class SQLStorageLoaderBase
 
 class SQLStorageLoader : public SQLStorageLoaderBase<SQLStorageLoader, SQLStorage>
 {
+    public:
+        static bool const CanUseSnapshot = true;
 };
 
 class SQLHashStorageLoader : public SQLStorageLoaderBase<SQLHashStorageLoader, SQLHashStorage>
 {
+    public:
+        static bool const CanUseSnapshot = true;
 };
 
 class SQLMultiStorageLoader : public SQLStorageLoaderBase<SQLMultiStorageLoader, SQLMultiStorage>
 {
+    public:
+        static bool const CanUseSnapshot = true;
 };
 
 #include "SQLStorageImpl.h"
@@ -20,6 +20,7 @@
 #define SQLSTORAGE_IMPL_H
 
 #include "Util/ProgressBar.h"
+#include "Util/Timer.h"
 #include "Log.h"
 #include "DBCFileLoader.h"
 
@@ -305,6 +306,25 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::storeValue(char const* v
 template<class DerivedLoader, class StorageClass>
 void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store, bool error_at_empty /*= true*/)
 {
+    uint32 startTime = WorldTimer::getMSTime();
+
+    // CHECKSUM TABLE is computed by the server, no row has to be sent and parsed
+    uint64 tableChecksum = 0;
+    if (DerivedLoader::CanUseSnapshot && SQLStorageBase::IsSnapshotEnabled())
+    {
+        if (QueryResult* checksumResult = WorldDatabase.PQuery("CHECKSUM TABLE %s", store.GetTableName()))
+        {
+            tableChecksum = (*checksumResult)[1].GetUInt64();
+            delete checksumResult;
+        }
+
+        if (tableChecksum && store.LoadSnapshot(tableChecksum))
+        {
+            sLog.outString("%s: %u records loaded from snapshot in %u ms", store.GetTableName(), store.GetRecordCount(), WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()));
+            return;
+        }
+    }
+
     Field* fields = nullptr;
     QueryResult* result  = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s", store.EntryFieldName(), store.GetTableName());
     if (!result)
@@ -351,43 +371,15 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
 
     // get struct size
     uint32 offset = 0;
-    for (uint32 x = 0; x < store.GetDstFieldCount(); ++x)
-    {
-        switch (store.GetDstFormat(x))
-        {
-            case FT_LOGIC:
-                recordsize += sizeof(bool);   break;
-            case FT_BYTE:
-                recordsize += sizeof(char);   break;
-            case FT_INT:
-                recordsize += sizeof(uint32); break;
-            case FT_FLOAT:
-                recordsize += sizeof(float);  break;
-            case FT_STRING:
-                recordsize += sizeof(char*);  break;
-            case FT_NA:
-                recordsize += sizeof(uint32); break;
-            case FT_NA_BYTE:
-                recordsize += sizeof(char);   break;
-            case FT_NA_FLOAT:
-                recordsize += sizeof(float);  break;
-            case FT_NA_POINTER:
-                recordsize += sizeof(char*);  break;
-            case FT_64BITINT:
-                recordsize += sizeof(uint64);  break;
-            case FT_IND:
-            case FT_SORT:
-                assert(false && "SQL storage not have sort field types");
-                break;
-            default:
-                assert(false && "unknown format character");
-                break;
-        }
-    }
+    recordsize = store.CalculateRecordSize();
 
     // Prepare data storage and lookup storage
     store.prepareToLoad(maxRecordId, recordCount, recordsize);
 
+    std::vector<uint32> recordIds;
+    if (tableChecksum)
+        recordIds.reserve(recordCount);
+
     BarGoLink bar(recordCount);
     do
     {
@@ -395,6 +387,8 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         bar.step();
 
         char* record = store.createRecord(fields[0].GetUInt32());
+        if (tableChecksum)
+            recordIds.push_back(fields[0].GetUInt32());
         offset = 0;
 
         // dependend on dest-size
@@ -445,6 +439,12 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     while (result->NextRow());
 
     delete result;
+
+    if (tableChecksum)
+    {
+        sLog.outString("%s: %u records loaded from database in %u ms", store.GetTableName(), store.GetRecordCount(), WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()));
+        store.SaveSnapshot(tableChecksum, recordIds);
+    }
 }
 
 #endif
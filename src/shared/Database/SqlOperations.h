@@ -64,6 +64,7 @@ class SqlTransaction : public SqlOperation
         ~SqlTransaction();
 
         void DelayExecute(SqlOperation* sql) { m_queue.push_back(sql); }
+        size_t GetSize() const { return m_queue.size(); }
 
         bool Execute(SqlConnection* conn) override;
 };
@@ -0,0 +1,94 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MPSCQUEUE_H
+#define MANGOS_MPSCQUEUE_H
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+/**
+ * Unbounded lock free queue for many producers and one consumer.
+ *
+ * Producers push with a single compare and swap on the head, they never wait for each other
+ * or for the consumer. The consumer takes everything pushed so far with a single exchange and
+ * walks it in push order, so elements pushed while it drains are left for the next Drain.
+ * Only one thread may drain at a time, no ABA problem exists because nodes are never popped one by one.
+ */
+template <class T>
+class MPSCQueue
+{
+    public:
+        MPSCQueue() : m_head(nullptr) {}
+        ~MPSCQueue() { Clear(); }
+
+        MPSCQueue(MPSCQueue const&) = delete;
+        MPSCQueue& operator=(MPSCQueue const&) = delete;
+
+        // any thread
+        void Push(T value)
+        {
+            Node* node = new Node(std::move(value));
+            node->next = m_head.load(std::memory_order_relaxed);
+            while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+                ;
+        }
+
+        // consumer only, calls function(T&) for every queued element, oldest first
+        template <class F>
+        void Drain(F function)
+        {
+            Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+
+            // pushes built the list newest first
+            Node* oldest = nullptr;
+            while (node)
+            {
+                Node* next = node->next;
+                node->next = oldest;
+                oldest = node;
+                node = next;
+            }
+
+            while (oldest)
+            {
+                std::unique_ptr<Node> current(oldest);
+                oldest = oldest->next;
+                function(current->value);
+            }
+        }
+
+        // consumer only
+        void Clear() { Drain([](T&) {}); }
+
+        bool IsEmpty() const { return m_head.load(std::memory_order_relaxed) == nullptr; }
+
+    private:
+        struct Node
+        {
+            explicit Node(T&& v) : value(std::move(v)), next(nullptr) {}
+
+            T value;
+            Node* next;
+        };
+
+        std::atomic<Node*> m_head;
+};
+
+#endif
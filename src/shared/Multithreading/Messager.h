@@ -19,8 +19,8 @@
 #ifndef MANGOS_MESSAGER_H
 #define MANGOS_MESSAGER_H
 
-#include <vector>
-#include <mutex>
+#include "Multithreading/MPSCQueue.h"
+
 #include <functional>
 
 template <class T>
@@ -29,24 +29,15 @@ class Messager
     public:
         void AddMessage(const std::function<void(T*)>& message)
         {
-            std::lock_guard<std::mutex> guard(m_messageMutex);
-            m_messageVector.push_back(message);
+            m_messages.Push(message);
         }
         void Execute(T* object)
         {
-            std::vector<std::function<void(T*)>> messageVectorCopy;
-            {
-                std::lock_guard<std::mutex> guard(m_messageMutex);
-                std::swap(m_messageVector, messageVectorCopy);
-            }
-            for (auto& message : messageVectorCopy)
-                message(object);
-
-            messageVectorCopy.clear();
+            // messages added by the executed ones wait for the next Execute
+            m_messages.Drain([object](std::function<void(T*)>& message) { message(object); });
         }
     private:
-        std::vector<std::function<void(T*)>> m_messageVector;
-        std::mutex m_messageMutex;  
+        MPSCQueue<std::function<void(T*)>> m_messages;
 };
 
 #endif
\ No newline at end of file